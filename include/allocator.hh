@@ -0,0 +1,577 @@
+#ifndef ALLOCATOR_HH
+#define ALLOCATOR_HH
+
+#include <limits>
+
+#include "common.hh"
+
+#if defined(__GLIBC__)
+    #include <malloc.h>
+#endif
+
+#if KT_LARGE_BUFFERS
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+NAMESPACE_KT_BEG
+
+namespace detail {
+
+    /**
+     * Thin wrappers over anonymous memory mappings used for large buffers.
+     * Sizes are always whole pages, see <code>round_to_pages()</code>.
+     * */
+    inline auto page_size() noexcept -> std::size_t
+    {
+#if KT_LARGE_BUFFERS
+        static const std::size_t size{ static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) };
+        return size;
+#else
+        return 4096;
+#endif
+    }
+
+    inline auto round_to_pages(std::size_t bytes) noexcept -> std::size_t
+    {
+        const auto page{ page_size() };
+        return (bytes + page - 1) / page * page;
+    }
+
+#if KT_LARGE_BUFFERS
+    inline auto advise_huge_pages(void* block, std::size_t bytes) noexcept -> void
+    {
+    #if defined(MADV_HUGEPAGE)
+        ::madvise(block, bytes, MADV_HUGEPAGE);
+    #else
+        static_cast<void>(block);
+        static_cast<void>(bytes);
+    #endif
+    }
+
+    inline auto map_pages(std::size_t bytes) noexcept -> void*
+    {
+        void* block{ ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0) };
+
+        if (block == MAP_FAILED)
+            return nullptr;
+
+        advise_huge_pages(block, bytes);
+        return block;
+    }
+
+    inline auto unmap_pages(void* block, std::size_t bytes) noexcept -> void
+    {
+        ::munmap(block, bytes);
+    }
+
+    inline auto remap_pages(void* block, std::size_t old_bytes, std::size_t new_bytes) noexcept -> void*
+    {
+        // the kernel moves the page table entries, no byte is copied
+        void* moved{ ::mremap(block, old_bytes, new_bytes, MREMAP_MAYMOVE) };
+
+        if (moved == MAP_FAILED)
+            return nullptr;
+
+        if (new_bytes > old_bytes)
+            advise_huge_pages(moved, new_bytes);
+
+        return moved;
+    }
+
+    inline auto discard_pages(void* block, std::size_t bytes) noexcept -> void
+    {
+        // private anonymous pages are dropped and read back as zeros
+        ::madvise(block, bytes, MADV_DONTNEED);
+    }
+#endif
+
+    /**
+     * Detects allocators able to release the physical memory behind a block whose
+     * contents are no longer needed, through <code>discard(pointer, count)</code>.
+     * */
+    template <typename Alloc, typename = void>
+    struct has_discard : std::false_type {};
+
+    template <typename Alloc>
+    struct has_discard<Alloc, std::void_t<decltype(std::declval<Alloc&>().discard(
+        std::declval<typename std::allocator_traits<Alloc>::pointer>(),
+        std::declval<typename std::allocator_traits<Alloc>::size_type>()))>> : std::true_type {};
+
+    template <typename Alloc>
+    inline constexpr bool has_discard_v = has_discard<Alloc>::value;
+
+} // namespace detail
+
+/**
+ * Default allocator used by the containers of this library. Allocation failures
+ * are reported by returning <code>nullptr</code> instead of throwing, which is what
+ * the containers expect when checking whether an allocation succeeded. During constant
+ * evaluation (C++20) blocks come from <code>std::allocator</code> instead.
+ *
+ * <p>Blocks of trivially copyable types of at least <code>KT_LARGE_BUFFER_THRESHOLD</code> bytes
+ * are served from anonymous memory mappings (Linux only) hinted with <code>MADV_HUGEPAGE</code>.
+ * Growing such a block goes through <code>mremap()</code>, which neither copies the contents
+ * nor keeps the old and the new block alive at the same time.</p>
+ * @tparam T type of the objects this allocator allocates storage for
+ * */
+template <typename T>
+class allocator
+{
+public:
+    using value_type        = T;
+    using pointer_type      = T*;
+    using size_type         = std::size_t;
+    using difference_type   = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment    = std::true_type;
+    using is_always_equal                           = std::true_type;
+
+    template <typename U>
+    struct rebind { using other = allocator<U>; };
+
+    constexpr allocator() noexcept = default;
+
+    template <typename U>
+    constexpr allocator(const allocator<U>&) noexcept {}
+
+    /**
+     * Allocates uninitialized storage for <code>count</code> objects of type <code>T</code>.
+     * @param count number of objects to allocate storage for
+     * @returns pointer to the allocated block or <code>nullptr</code> on failure
+     * */
+    [[nodiscard]]
+    KT_CONSTEXPR auto allocate(size_type count) -> pointer_type
+    {
+        // the size in bytes would wrap around and a too small block would be handed out
+        if (count > max_size())
+            return nullptr;
+
+#if KT_CONSTEXPR_VECTOR
+        // only std::allocator can hand out storage during constant evaluation
+        if (std::is_constant_evaluated())
+            return std::allocator<value_type>{}.allocate(count);
+#endif
+#if KT_LARGE_BUFFERS
+        if (is_large(count))
+            return static_cast<pointer_type>(detail::map_pages(mapping_size(count)));
+#endif
+        return heap_allocate(count);
+    }
+
+    /**
+     * Frees a block previously obtained from <code>allocate()</code>.
+     * @param ptr pointer to the block to be freed
+     * @param count number of objects the block was allocated for
+     * */
+    KT_CONSTEXPR auto deallocate(pointer_type ptr, size_type count) noexcept -> void
+    {
+#if KT_CONSTEXPR_VECTOR
+        if (std::is_constant_evaluated())
+            return std::allocator<value_type>{}.deallocate(ptr, count);
+#endif
+#if KT_LARGE_BUFFERS
+        if (is_large(count))
+            return detail::unmap_pages(ptr, mapping_size(count));
+#else
+        static_cast<void>(count);
+#endif
+        heap_deallocate(ptr);
+    }
+
+    /**
+     * Resizes the block at <code>ptr</code> to hold <code>new_count</code> objects, in place
+     * if the underlying heap allows it. The bytes of the first <code>min(old_count, new_count)</code>
+     * objects are preserved, so this is only suitable for trivially copyable types.
+     * @param ptr block previously obtained from this allocator
+     * @param old_count number of objects the block was allocated for
+     * @param new_count number of objects the block must be able to hold
+     * @returns pointer to the resized block or <code>nullptr</code> on failure, in which
+     * case <code>ptr</code> is still valid and owned by the caller
+     * */
+    [[nodiscard]]
+    auto reallocate(pointer_type ptr, size_type old_count, size_type new_count) -> pointer_type
+    {
+        if (new_count > max_size())
+            return nullptr;
+
+#if KT_LARGE_BUFFERS
+        if (is_large(old_count) && is_large(new_count))
+            return static_cast<pointer_type>(detail::remap_pages(ptr, mapping_size(old_count), mapping_size(new_count)));
+
+        if (is_large(old_count) || is_large(new_count))
+        {
+            // crossing the threshold, the block changes kind and must be copied once;
+            // exactly one side is large and the small one bounds the copy
+            pointer_type block{ allocate(new_count) };
+            const size_type kept{ is_large(new_count) ? old_count : new_count };
+
+            if (block != nullptr)
+            {
+                std::memcpy(static_cast<void*>(block), static_cast<const void*>(ptr), sizeof(value_type) * kept);
+                deallocate(ptr, old_count);
+            }
+
+            return block;
+        }
+#endif
+        return heap_reallocate(ptr, old_count, new_count);
+    }
+
+    /**
+     * Returns the largest number of objects a single block can be requested for, bigger
+     * requests fail since their size in bytes does not fit in a <code>size_type</code>.
+     * @returns maximum value of <code>count</code> accepted by <code>allocate()</code>
+     * */
+    [[nodiscard]]
+    constexpr auto max_size() const noexcept -> size_type
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+    /**
+     * Returns how many objects actually fit in the block at <code>ptr</code>, which
+     * may be more than requested since the heap rounds blocks up to its size classes
+     * and mappings are made of whole pages.
+     * @param ptr block previously obtained from this allocator
+     * @param count number of objects the block was requested for
+     * @returns number of objects the block can hold, never less than <code>count</code>
+     * */
+    [[nodiscard]]
+    auto usable_size(pointer_type ptr, size_type count) const noexcept -> size_type
+    {
+#if KT_LARGE_BUFFERS
+        if (is_large(count))
+            return mapping_size(count) / sizeof(value_type);
+#endif
+#if defined(__GLIBC__)
+        if constexpr (!over_aligned)
+        {
+            size_type usable{ ::malloc_usable_size(static_cast<void*>(ptr)) / sizeof(value_type) };
+
+            // the block must still be recognised as a heap block when given back
+            if constexpr (large_buffers)
+                usable = std::min(usable, (KT_LARGE_BUFFER_THRESHOLD - 1) / sizeof(value_type));
+
+            return std::max(count, usable);
+        }
+#endif
+        static_cast<void>(ptr);
+        return count;
+    }
+
+    /**
+     * Gives the physical pages of a mapped block back to the system while keeping the block
+     * valid, its contents read as zeros afterwards. Heap blocks are left untouched.
+     * @param ptr block previously obtained from this allocator, holding no live object
+     * @param count number of objects the block was allocated for
+     * */
+    auto discard(pointer_type ptr, size_type count) noexcept -> void
+    {
+#if KT_LARGE_BUFFERS
+        if (is_large(count))
+            detail::discard_pages(static_cast<void*>(ptr), mapping_size(count));
+#else
+        static_cast<void>(ptr);
+        static_cast<void>(count);
+#endif
+    }
+
+private:
+    static constexpr bool over_aligned{ alignof(value_type) > alignof(std::max_align_t) };
+
+    static constexpr bool large_buffers{ KT_LARGE_BUFFERS && std::is_trivially_copyable_v<value_type> &&
+                                         alignof(value_type) <= 4096 };
+
+    static constexpr auto is_large(size_type count) noexcept -> bool
+    {
+        return large_buffers && sizeof(value_type) * count >= KT_LARGE_BUFFER_THRESHOLD;
+    }
+
+    static auto mapping_size(size_type count) noexcept -> size_type
+    {
+        return detail::round_to_pages(sizeof(value_type) * count);
+    }
+
+    static auto heap_allocate(size_type count) noexcept -> pointer_type
+    {
+        if constexpr (over_aligned)
+            return static_cast<pointer_type>(::operator new(sizeof(value_type) * count,
+                                                            std::align_val_t{ alignof(value_type) }, std::nothrow));
+        else
+            return static_cast<pointer_type>(std::malloc(sizeof(value_type) * count));
+    }
+
+    static auto heap_deallocate(pointer_type ptr) noexcept -> void
+    {
+        if constexpr (over_aligned)
+            ::operator delete(static_cast<void*>(ptr), std::align_val_t{ alignof(value_type) });
+        else
+            std::free(static_cast<void*>(ptr));
+    }
+
+    static auto heap_reallocate(pointer_type ptr, size_type old_count, size_type new_count) noexcept -> pointer_type
+    {
+        if constexpr (over_aligned)
+        {
+            // realloc() only guarantees fundamental alignment, fall back to a fresh block
+            pointer_type block{ heap_allocate(new_count) };
+
+            if (block != nullptr)
+            {
+                std::memcpy(static_cast<void*>(block), static_cast<const void*>(ptr),
+                            sizeof(value_type) * std::min(old_count, new_count));
+                heap_deallocate(ptr);
+            }
+
+            return block;
+        }
+        else
+        {
+            static_cast<void>(old_count);
+            return static_cast<pointer_type>(std::realloc(static_cast<void*>(ptr), sizeof(value_type) * new_count));
+        }
+    }
+};
+
+template <typename T, typename U>
+constexpr auto operator==(const allocator<T>&, const allocator<U>&) noexcept -> bool { return true; }
+
+template <typename T, typename U>
+constexpr auto operator!=(const allocator<T>&, const allocator<U>&) noexcept -> bool { return false; }
+
+
+/**
+ * Size in bytes of a cache line on the targets this library is tuned for.
+ * */
+inline constexpr std::size_t cache_line_size{ 64 };
+
+/**
+ * Allocator handing out blocks aligned to <code>Alignment</code> bytes, typically a cache
+ * line or the width of a vector register (32 bytes for AVX2, 64 bytes for AVX-512), so
+ * kernels running over the buffer can use aligned loads and stores.
+ * Pair it with <code>growth::padded</code> to also keep the capacity a whole number of
+ * vector widths (see <code>kt::aligned_vector</code>).
+ * @tparam T type of the objects this allocator allocates storage for
+ * @tparam Alignment alignment of every block, a power of two not smaller than <code>alignof(T)</code>
+ * */
+template <typename T, std::size_t Alignment = cache_line_size>
+class aligned_allocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "the alignment must be a power of two");
+    static_assert(Alignment >= alignof(T), "the alignment cannot be weaker than the one of T");
+
+public:
+    using value_type        = T;
+    using pointer_type      = T*;
+    using size_type         = std::size_t;
+    using difference_type   = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment    = std::true_type;
+    using is_always_equal                           = std::true_type;
+
+    static constexpr std::size_t alignment{ Alignment };
+
+    template <typename U>
+    struct rebind { using other = aligned_allocator<U, std::max(Alignment, alignof(U))>; };
+
+    constexpr aligned_allocator() noexcept = default;
+
+    template <typename U, std::size_t OtherAlignment>
+    constexpr aligned_allocator(const aligned_allocator<U, OtherAlignment>&) noexcept {}
+
+    /**
+     * Allocates uninitialized storage for <code>count</code> objects of type <code>T</code>
+     * starting at an <code>Alignment</code> boundary.
+     * @param count number of objects to allocate storage for
+     * @returns pointer to the allocated block or <code>nullptr</code> on failure
+     * */
+    [[nodiscard]]
+    auto allocate(size_type count) -> pointer_type
+    {
+        if (count > max_size())
+            return nullptr;
+
+        return static_cast<pointer_type>(::operator new(sizeof(value_type) * count, std::align_val_t{ Alignment }, std::nothrow));
+    }
+
+    /**
+     * Frees a block previously obtained from <code>allocate()</code>.
+     * @param ptr pointer to the block to be freed
+     * @param count number of objects the block was allocated for
+     * */
+    auto deallocate(pointer_type ptr, size_type count) noexcept -> void
+    {
+        static_cast<void>(count);
+        ::operator delete(static_cast<void*>(ptr), std::align_val_t{ Alignment });
+    }
+
+    /**
+     * Returns the largest number of objects a single block can be requested for.
+     * @returns maximum value of <code>count</code> accepted by <code>allocate()</code>
+     * */
+    [[nodiscard]]
+    constexpr auto max_size() const noexcept -> size_type
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+};
+
+template <typename T, std::size_t A, typename U, std::size_t B>
+constexpr auto operator==(const aligned_allocator<T, A>&, const aligned_allocator<U, B>&) noexcept -> bool { return A == B; }
+
+template <typename T, std::size_t A, typename U, std::size_t B>
+constexpr auto operator!=(const aligned_allocator<T, A>&, const aligned_allocator<U, B>&) noexcept -> bool { return A != B; }
+
+
+/**
+ * Monotonic memory resource that hands out chunks of a caller provided buffer.
+ * Individual deallocations are no-ops except for the most recent allocation,
+ * which can be given back so short-lived vectors growing inside the arena can
+ * reuse the tail. The whole arena is recycled at once by calling <code>reset()</code>.
+ * */
+class arena
+{
+public:
+    arena(void* buffer, std::size_t size) noexcept
+        :   m_begin{ static_cast<unsigned char*>(buffer) }, m_current{ m_begin }, m_end{ m_begin + size }
+    {}
+
+    arena(const arena&) = delete;
+    auto operator=(const arena&) -> arena& = delete;
+
+    /**
+     * Returns a block of at least <code>size</code> bytes aligned to <code>alignment</code>.
+     * @param size number of bytes requested
+     * @param alignment required alignment, must be a power of two
+     * @returns pointer to the block or <code>nullptr</code> if the arena is exhausted
+     * */
+    [[nodiscard]]
+    auto allocate(std::size_t size, std::size_t alignment) noexcept -> void*
+    {
+        const auto address{ reinterpret_cast<std::uintptr_t>(this->m_current) };
+        const auto padding{ (alignment - (address & (alignment - 1))) & (alignment - 1) };
+
+        const auto remaining{ static_cast<std::size_t>(this->m_end - this->m_current) };
+
+        // compared separately so a huge size cannot wrap the sum around
+        if (remaining < padding || remaining - padding < size)
+            return nullptr;
+
+        this->m_last = this->m_current + padding;
+        this->m_current = this->m_last + size;
+
+        return this->m_last;
+    }
+
+    /**
+     * Gives back the block at <code>ptr</code> if it was the last one handed out.
+     * @param ptr block to be released
+     * */
+    auto deallocate(void* ptr) noexcept -> void
+    {
+        if (ptr != nullptr && ptr == this->m_last)
+        {
+            this->m_current = this->m_last;
+            this->m_last = nullptr;
+        }
+    }
+
+    /**
+     * Makes the whole buffer available again. Every block handed out so far becomes invalid.
+     * */
+    auto reset() noexcept -> void
+    {
+        this->m_current = this->m_begin;
+        this->m_last = nullptr;
+    }
+
+    /**
+     * Returns the number of bytes still available in this arena.
+     * @returns remaining bytes
+     * */
+    [[nodiscard]]
+    auto available() const noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(this->m_end - this->m_current);
+    }
+
+private:
+    unsigned char*  m_begin;
+    unsigned char*  m_current;
+    unsigned char*  m_end;
+    unsigned char*  m_last{};
+};
+
+/**
+ * Allocator adaptor that serves memory from a <code>kt::arena</code>. Copies of this
+ * allocator share the same arena and compare equal only if they point to the same one.
+ * @tparam T type of the objects this allocator allocates storage for
+ * */
+template <typename T>
+class arena_allocator
+{
+public:
+    using value_type        = T;
+    using pointer_type      = T*;
+    using size_type         = std::size_t;
+    using difference_type   = std::ptrdiff_t;
+
+    using propagate_on_container_copy_assignment    = std::true_type;
+    using propagate_on_container_move_assignment    = std::true_type;
+    using propagate_on_container_swap               = std::true_type;
+
+    template <typename U>
+    struct rebind { using other = arena_allocator<U>; };
+
+    explicit arena_allocator(arena& source) noexcept
+        :   m_arena{ &source }
+    {}
+
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other) noexcept
+        :   m_arena{ other.resource() }
+    {}
+
+    [[nodiscard]]
+    auto allocate(size_type count) -> pointer_type
+    {
+        if (count > max_size())
+            return nullptr;
+
+        return static_cast<pointer_type>(this->m_arena->allocate(sizeof(value_type) * count, alignof(value_type)));
+    }
+
+    auto deallocate(pointer_type ptr, size_type) noexcept -> void
+    {
+        this->m_arena->deallocate(ptr);
+    }
+
+    [[nodiscard]]
+    constexpr auto max_size() const noexcept -> size_type
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+    [[nodiscard]]
+    auto resource() const noexcept -> arena* { return this->m_arena; }
+
+private:
+    arena* m_arena;
+};
+
+template <typename T, typename U>
+auto operator==(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept -> bool
+{
+    return lhs.resource() == rhs.resource();
+}
+
+template <typename T, typename U>
+auto operator!=(const arena_allocator<T>& lhs, const arena_allocator<U>& rhs) noexcept -> bool
+{
+    return !(lhs == rhs);
+}
+
+NAMESPACE_KT_END
+
+#endif // ALLOCATOR_HH
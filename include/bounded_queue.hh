@@ -0,0 +1,581 @@
+#ifndef BOUNDED_QUEUE_HH
+#define BOUNDED_QUEUE_HH
+
+#include <atomic>
+#include <new>
+
+#include "common.hh"
+#include "allocator.hh"
+#include "vector.hh"
+
+NAMESPACE_KT_BEG
+
+namespace detail {
+
+    /**
+     * Rounds the requested capacity of a bounded queue up to a power of two (at least one),
+     * so positions map to slots with a mask.
+     * */
+    inline auto queue_capacity(std::size_t requested) noexcept -> std::size_t
+    {
+        std::size_t capacity{ 1 };
+
+        while (capacity < requested)
+            capacity *= 2;
+
+        return capacity;
+    }
+
+    /**
+     * Raw storage for one element of a bounded queue. Slots are plain bytes, the queue decides
+     * which ones hold a live element.
+     * */
+    template <typename T>
+    struct spsc_slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    /**
+     * Storage for one element of <code>mpmc_queue</code> plus its sequence number, which tells
+     * producers and consumers of which lap the slot is ready for.
+     * */
+    template <typename T>
+    struct mpmc_slot
+    {
+        std::atomic<std::size_t>    sequence{ 0 };
+        alignas(T) unsigned char    storage[sizeof(T)];
+
+        mpmc_slot() noexcept = default;
+
+        // slots are only copied while the queue fills its buffer, before any thread can see them
+        mpmc_slot(const mpmc_slot& other) noexcept
+            :   sequence{ other.sequence.load(std::memory_order_relaxed) }
+        {}
+    };
+
+} // namespace detail
+
+/**
+ * Lock free bounded queue for exactly one producer thread and one consumer thread.
+ * Its slots are a <code>kt::vector</code> allocated once by the constructor; after that pushing
+ * and popping never allocate nor lock. The producer owns the tail index and the consumer the
+ * head index, each on its own cache line together with a private copy of the other side's index,
+ * so the two threads only touch each other's line when the queue looks full or empty.
+ *
+ * <p>Every member except <code>size()</code>, <code>empty()</code> and <code>capacity()</code> is
+ * either a producer operation (<code>try_push</code>, <code>try_emplace</code>, <code>try_push_n</code>)
+ * or a consumer operation (<code>try_pop</code>, <code>try_pop_n</code>), and each kind must only
+ * be called from its own thread.</p>
+ * @tparam T type of the elements
+ * @tparam Alloc allocator providing the slots
+ * */
+template <typename T, typename Alloc = allocator<T>>
+class spsc_queue
+{
+    using slot_type             = detail::spsc_slot<T>;
+    using slot_allocator_type   = typename std::allocator_traits<Alloc>::template rebind_alloc<slot_type>;
+
+public:
+    using value_type            = T;
+    using allocator_type        = Alloc;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+    using const_reference_type  = const T&;
+
+    /**
+     * Constructs an empty queue able to hold <code>capacity</code> elements, rounded up to a
+     * power of two. This is the only allocation the queue ever makes.
+     * @param capacity minimum number of elements the queue can hold at once
+     * @param alloc allocator providing the slots
+     * @throws std::bad_alloc if the slots cannot be allocated
+     * */
+    explicit
+    spsc_queue(size_type capacity, const allocator_type& alloc = allocator_type())
+        :   m_slots(detail::queue_capacity(capacity), slot_type{}, slot_allocator_type(alloc))
+    {
+        if (this->m_slots.empty())
+            throw std::bad_alloc();
+
+        this->m_mask = this->m_slots.size() - 1;
+    }
+
+    spsc_queue(const spsc_queue&) = delete;
+    auto operator=(const spsc_queue&) -> spsc_queue& = delete;
+
+    /**
+     * Destroys the elements that were never popped.
+     * */
+    ~spsc_queue()
+    {
+        const size_type tail{ this->m_tail.load(std::memory_order_relaxed) };
+
+        for (size_type head{ this->m_head.load(std::memory_order_relaxed) }; head != tail; ++head)
+            std::destroy_at(slot(head));
+    }
+
+    /**
+     * Producer only. Appends an element constructed in place from <code>args</code> if there is room.
+     * @param args arguments forwarded to the constructor of the element
+     * @returns <code>true</code> if the element was added, <code>false</code> if the queue is full
+     * */
+    template <typename... Args>
+    auto try_emplace(Args&&... args) -> bool
+    {
+        const size_type tail{ this->m_tail.load(std::memory_order_relaxed) };
+
+        if (free_slots(tail) == 0)
+            return false;
+
+        ::new (static_cast<void*>(slot(tail))) value_type(std::forward<Args>(args)...);
+        this->m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Producer only. Appends a copy of <code>value</code> if there is room.
+     * @param value value to be copied
+     * @returns <code>true</code> if the element was added, <code>false</code> if the queue is full
+     * */
+    auto try_push(const value_type& value) -> bool
+    {
+        return try_emplace(value);
+    }
+
+    /**
+     * Producer only. Appends <code>value</code> by moving it if there is room.
+     * @param value value to be moved, left untouched if the queue is full
+     * @returns <code>true</code> if the element was added, <code>false</code> if the queue is full
+     * */
+    auto try_push(value_type&& value) -> bool
+    {
+        return try_emplace(std::move(value));
+    }
+
+    /**
+     * Producer only. Appends copies of as many of the <code>count</code> elements starting at
+     * <code>first</code> as fit, publishing them to the consumer with a single store.
+     * Pass a <code>std::move_iterator</code> to move them instead.
+     * @param first iterator to the first element to be appended
+     * @param count number of elements available from <code>first</code>
+     * @returns number of elements appended, from the beginning of the range
+     * */
+    template <typename InputIt>
+    auto try_push_n(InputIt first, size_type count) -> size_type
+    {
+        const size_type tail{ this->m_tail.load(std::memory_order_relaxed) };
+        const size_type total{ std::min(count, free_slots(tail)) };
+        size_type built{};
+
+        try
+        {
+            for (; built < total; ++built, ++first)
+                ::new (static_cast<void*>(slot(tail + built))) value_type(*first);
+        }
+        catch (...)
+        {
+            // the elements already built are handed over, the failed one is not
+            this->m_tail.store(tail + built, std::memory_order_release);
+            throw;
+        }
+
+        this->m_tail.store(tail + total, std::memory_order_release);
+
+        return total;
+    }
+
+    /**
+     * Consumer only. Moves the front element into <code>out</code> and removes it.
+     * @param out receives the front element
+     * @returns <code>true</code> if an element was popped, <code>false</code> if the queue is empty
+     * */
+    auto try_pop(value_type& out) -> bool
+    {
+        return try_pop_n(&out, 1) == 1;
+    }
+
+    /**
+     * Consumer only. Moves up to <code>count</code> elements from the front into the range starting
+     * at <code>out</code> and frees their slots to the producer with a single store.
+     * @param out iterator the popped elements are assigned through
+     * @param count maximum number of elements to pop
+     * @returns number of elements popped
+     * */
+    template <typename OutputIt>
+    auto try_pop_n(OutputIt out, size_type count) -> size_type
+    {
+        const size_type head{ this->m_head.load(std::memory_order_relaxed) };
+        const size_type total{ std::min(count, used_slots(head)) };
+        size_type moved{};
+
+        try
+        {
+            for (; moved < total; ++moved, ++out)
+            {
+                pointer_type item{ slot(head + moved) };
+
+                *out = std::move(*item);
+                std::destroy_at(item);
+            }
+        }
+        catch (...)
+        {
+            // the element that failed to move stays at the front
+            this->m_head.store(head + moved, std::memory_order_release);
+            throw;
+        }
+
+        this->m_head.store(head + total, std::memory_order_release);
+
+        return total;
+    }
+
+    /**
+     * Returns the number of elements in the queue. Only a snapshot when the other thread is running.
+     * @returns number of elements
+     * */
+    [[nodiscard]]
+    auto size() const noexcept -> size_type
+    {
+        // the head is read first, the tail read afterwards can only be further ahead
+        const size_type head{ this->m_head.load(std::memory_order_acquire) };
+        return this->m_tail.load(std::memory_order_acquire) - head;
+    }
+
+    [[nodiscard]]
+    auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /**
+     * Returns the number of elements the queue can hold at once.
+     * @returns capacity of the queue, a power of two
+     * */
+    [[nodiscard]]
+    auto capacity() const noexcept -> size_type
+    {
+        return this->m_slots.size();
+    }
+
+private:
+    auto slot(size_type position) noexcept -> pointer_type
+    {
+        return std::launder(reinterpret_cast<pointer_type>(this->m_slots[position & this->m_mask].storage));
+    }
+
+    /**
+     * Producer side: number of free slots, reloading the consumer's head only when the cached
+     * copy says there are none.
+     * */
+    auto free_slots(size_type tail) noexcept -> size_type
+    {
+        if (tail - this->m_head_cache == capacity())
+            this->m_head_cache = this->m_head.load(std::memory_order_acquire);
+
+        return capacity() - (tail - this->m_head_cache);
+    }
+
+    /**
+     * Consumer side: number of elements ready to pop, reloading the producer's tail only when
+     * the cached copy says there are none.
+     * */
+    auto used_slots(size_type head) noexcept -> size_type
+    {
+        if (this->m_tail_cache == head)
+            this->m_tail_cache = this->m_tail.load(std::memory_order_acquire);
+
+        return this->m_tail_cache - head;
+    }
+
+    // read only after construction
+    vector<slot_type, slot_allocator_type>              m_slots;
+    size_type                                           m_mask{ 0 };
+
+    // written by the producer
+    alignas(cache_line_size) std::atomic<size_type>     m_tail{ 0 };
+    size_type                                           m_head_cache{ 0 };
+
+    // written by the consumer
+    alignas(cache_line_size) std::atomic<size_type>     m_head{ 0 };
+    size_type                                           m_tail_cache{ 0 };
+};
+
+/**
+ * Lock free bounded queue for any number of producer and consumer threads, after Dmitry Vyukov's
+ * design. Its slots are a <code>kt::vector</code> allocated once by the constructor, each with a
+ * sequence number: a producer claims the position at the tail with a compare-and-swap once the slot
+ * has been freed for that lap, builds the element and bumps the sequence to hand it to consumers,
+ * which claim positions at the head the same way. Threads only contend on the head or tail index
+ * (each on its own cache line) and never wait for one another unless the queue is full or empty.
+ *
+ * <p>An element whose position was claimed must be built and taken without failing, otherwise the
+ * queue would stall at that position, so constructing and moving elements must not throw.</p>
+ * @tparam T type of the elements, nothrow move constructible and move assignable
+ * @tparam Alloc allocator providing the slots
+ * */
+template <typename T, typename Alloc = allocator<T>>
+class mpmc_queue
+{
+    static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+        "a claimed slot cannot be given back, moving elements in and out of it must not throw");
+
+    using slot_type             = detail::mpmc_slot<T>;
+    using slot_allocator_type   = typename std::allocator_traits<Alloc>::template rebind_alloc<slot_type>;
+
+public:
+    using value_type            = T;
+    using allocator_type        = Alloc;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+    using const_reference_type  = const T&;
+
+    /**
+     * Constructs an empty queue able to hold <code>capacity</code> elements, rounded up to a
+     * power of two. This is the only allocation the queue ever makes.
+     * @param capacity minimum number of elements the queue can hold at once
+     * @param alloc allocator providing the slots
+     * @throws std::bad_alloc if the slots cannot be allocated
+     * */
+    explicit
+    mpmc_queue(size_type capacity, const allocator_type& alloc = allocator_type())
+        :   m_slots(detail::queue_capacity(capacity), slot_type{}, slot_allocator_type(alloc))
+    {
+        if (this->m_slots.empty())
+            throw std::bad_alloc();
+
+        this->m_mask = this->m_slots.size() - 1;
+
+        // slot i is first free for the producer claiming position i
+        for (size_type index{}; index < this->m_slots.size(); ++index)
+            this->m_slots[index].sequence.store(index, std::memory_order_relaxed);
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    auto operator=(const mpmc_queue&) -> mpmc_queue& = delete;
+
+    /**
+     * Destroys the elements that were never popped. No other thread may use the queue anymore.
+     * */
+    ~mpmc_queue()
+    {
+        const size_type tail{ this->m_tail.load(std::memory_order_relaxed) };
+
+        for (size_type head{ this->m_head.load(std::memory_order_relaxed) }; head != tail; ++head)
+            std::destroy_at(element(head));
+    }
+
+    /**
+     * Appends an element constructed from <code>args</code> if there is room. The element is built
+     * in place when its constructor cannot throw, otherwise it is built before claiming a slot and
+     * moved in. Safe to call from many threads at once.
+     * @param args arguments forwarded to the constructor of the element
+     * @returns <code>true</code> if the element was added, <code>false</code> if the queue is full
+     * */
+    template <typename... Args>
+    auto try_emplace(Args&&... args) -> bool
+    {
+        if constexpr (!std::is_nothrow_constructible_v<value_type, Args&&...>)
+        {
+            value_type value(std::forward<Args>(args)...);
+            return try_emplace(std::move(value));
+        }
+        else
+        {
+            size_type position{};
+
+            if (claim(this->m_tail, 0, 1, position) == 0)
+                return false;
+
+            ::new (static_cast<void*>(element(position))) value_type(std::forward<Args>(args)...);
+            this->m_slots[position & this->m_mask].sequence.store(position + 1, std::memory_order_release);
+
+            return true;
+        }
+    }
+
+    /**
+     * Appends a copy of <code>value</code> if there is room. Safe to call from many threads at once.
+     * @param value value to be copied
+     * @returns <code>true</code> if the element was added, <code>false</code> if the queue is full
+     * */
+    auto try_push(const value_type& value) -> bool
+    {
+        return try_emplace(value);
+    }
+
+    /**
+     * Appends <code>value</code> by moving it if there is room. Safe to call from many threads at once.
+     * @param value value to be moved, left untouched if the queue is full
+     * @returns <code>true</code> if the element was added, <code>false</code> if the queue is full
+     * */
+    auto try_push(value_type&& value) -> bool
+    {
+        return try_emplace(std::move(value));
+    }
+
+    /**
+     * Appends copies of as many of the <code>count</code> elements starting at <code>first</code>
+     * as there are free consecutive slots, claiming all of them with one compare-and-swap.
+     * The elements are contiguous in the queue. Safe to call from many threads at once.
+     * Building an element must not throw, for elements whose copies can throw pass a
+     * <code>std::move_iterator</code> so they are moved instead.
+     * @param first iterator to the first element to be appended
+     * @param count number of elements available from <code>first</code>
+     * @returns number of elements appended, from the beginning of the range
+     * */
+    template <typename InputIt>
+    auto try_push_n(InputIt first, size_type count) -> size_type
+    {
+        static_assert(std::is_nothrow_constructible_v<value_type, decltype(*first)>,
+            "the elements are built after their slots were claimed, their constructor must not throw");
+
+        size_type position{};
+        const size_type total{ claim(this->m_tail, 0, count, position) };
+
+        for (size_type index{}; index < total; ++index, ++first)
+        {
+            ::new (static_cast<void*>(element(position + index))) value_type(*first);
+            this->m_slots[(position + index) & this->m_mask].sequence.store(position + index + 1, std::memory_order_release);
+        }
+
+        return total;
+    }
+
+    /**
+     * Moves the front element into <code>out</code> and removes it. Safe to call from many
+     * threads at once.
+     * @param out receives the front element
+     * @returns <code>true</code> if an element was popped, <code>false</code> if the queue is empty
+     * */
+    auto try_pop(value_type& out) -> bool
+    {
+        return try_pop_n(&out, 1) == 1;
+    }
+
+    /**
+     * Moves up to <code>count</code> consecutive elements from the front into the range starting
+     * at <code>out</code>, claiming all of them with one compare-and-swap. Safe to call from many
+     * threads at once.
+     * @param out iterator the popped elements are assigned through, assigning must not throw
+     * @param count maximum number of elements to pop
+     * @returns number of elements popped
+     * */
+    template <typename OutputIt>
+    auto try_pop_n(OutputIt out, size_type count) -> size_type
+    {
+        size_type position{};
+        const size_type total{ claim(this->m_head, 1, count, position) };
+
+        for (size_type index{}; index < total; ++index, ++out)
+        {
+            pointer_type item{ element(position + index) };
+
+            *out = std::move(*item);
+            std::destroy_at(item);
+
+            // free for the producer of the next lap
+            this->m_slots[(position + index) & this->m_mask].sequence.store(
+                position + index + capacity(), std::memory_order_release);
+        }
+
+        return total;
+    }
+
+    /**
+     * Returns the number of claimed positions, including elements still being built or taken.
+     * Only a snapshot while other threads are running.
+     * @returns number of elements
+     * */
+    [[nodiscard]]
+    auto size() const noexcept -> size_type
+    {
+        // consumers never claim past producers, reading the head first keeps the difference positive
+        const size_type head{ this->m_head.load(std::memory_order_acquire) };
+        return std::min(this->m_tail.load(std::memory_order_acquire) - head, capacity());
+    }
+
+    [[nodiscard]]
+    auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /**
+     * Returns the number of elements the queue can hold at once.
+     * @returns capacity of the queue, a power of two
+     * */
+    [[nodiscard]]
+    auto capacity() const noexcept -> size_type
+    {
+        return this->m_slots.size();
+    }
+
+private:
+    auto element(size_type position) noexcept -> pointer_type
+    {
+        return std::launder(reinterpret_cast<pointer_type>(this->m_slots[position & this->m_mask].storage));
+    }
+
+    /**
+     * Claims up to <code>count</code> consecutive positions from <code>index</code> (the tail for
+     * producers, the head for consumers). The slot of position <code>p</code> is ready when its
+     * sequence is <code>p + lag</code>: <code>lag</code> is 0 for producers (freed by the consumer of
+     * the previous lap) and 1 for consumers (filled by the producer of this lap). Only a run of ready
+     * slots is claimed; nobody else can change them before the compare-and-swap since that requires
+     * claiming them first.
+     * @param position receives the first claimed position
+     * @returns number of positions claimed, 0 if the queue is full (producers) or empty (consumers)
+     * */
+    auto claim(std::atomic<size_type>& index, size_type lag, size_type count, size_type& position) noexcept -> size_type
+    {
+        position = index.load(std::memory_order_relaxed);
+
+        while (count != 0)
+        {
+            size_type ready{};
+
+            for (; ready < count && ready <= this->m_mask; ++ready)
+            {
+                const size_type expected{ position + ready + lag };
+
+                if (this->m_slots[(position + ready) & this->m_mask].sequence.load(std::memory_order_acquire) != expected)
+                    break;
+            }
+
+            if (ready != 0)
+            {
+                if (index.compare_exchange_weak(position, position + ready, std::memory_order_relaxed))
+                    return ready;
+
+                // another thread claimed first, position now holds the current index
+                continue;
+            }
+
+            const size_type sequence{ this->m_slots[position & this->m_mask].sequence.load(std::memory_order_acquire) };
+
+            // behind the index: the slot still belongs to the previous lap, the queue is full or empty
+            if (static_cast<std::ptrdiff_t>(sequence - (position + lag)) < 0)
+                return 0;
+
+            // ahead of it: another thread already claimed this position
+            position = index.load(std::memory_order_relaxed);
+        }
+
+        return 0;
+    }
+
+    // read only after construction
+    vector<slot_type, slot_allocator_type>              m_slots;
+    size_type                                           m_mask{ 0 };
+
+    alignas(cache_line_size) std::atomic<size_type>     m_tail{ 0 };
+    alignas(cache_line_size) std::atomic<size_type>     m_head{ 0 };
+};
+
+NAMESPACE_KT_END
+
+#endif // BOUNDED_QUEUE_HH
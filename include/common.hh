@@ -6,6 +6,8 @@
 #include <memory>
 #include <cstring>
 #include <cassert>
+#include <cstddef>
+#include <cstdlib>
 #include <cstdint>
 #include <utility>
 #include <iterator>
@@ -20,7 +22,61 @@
     #include <cstdio>
 #endif
 
+// Large-buffer mode: blocks of trivially copyable elements at or above this many
+// bytes are mapped straight from the kernel and grown with mremap() (Linux only).
+// Define KT_LARGE_BUFFERS to 0 to always use the regular heap.
+#if !defined(KT_LARGE_BUFFERS)
+    #if defined(__linux__)
+        #define KT_LARGE_BUFFERS 1
+    #else
+        #define KT_LARGE_BUFFERS 0
+    #endif
+#endif
+
+#if !defined(KT_LARGE_BUFFER_THRESHOLD)
+    #define KT_LARGE_BUFFER_THRESHOLD (std::size_t{ 32 } << 20)
+#endif
+
+// Allocation and growth counters for kt::vector (see stats.hh). Off by default, when
+// disabled vectors carry no instrumentation at all.
+#if !defined(KT_VECTOR_STATS)
+    #define KT_VECTOR_STATS 0
+#endif
+
+// Constant evaluation of kt::vector: with C++20 transient allocation (P0784) vectors can be
+// built and used inside constant expressions. KT_CONSTEXPR marks the functions taking part in
+// it and expands to nothing on C++17, which keeps the baseline unchanged.
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_constexpr_dynamic_alloc) && \
+    defined(__cpp_lib_is_constant_evaluated)
+    #define KT_CONSTEXPR_VECTOR 1
+    #define KT_CONSTEXPR constexpr
+#else
+    #define KT_CONSTEXPR_VECTOR 0
+    #define KT_CONSTEXPR
+#endif
+
 #define NAMESPACE_KT_BEG namespace kt {
 #define NAMESPACE_KT_END }
 
+NAMESPACE_KT_BEG
+
+namespace detail {
+
+    /**
+     * <code>std::is_constant_evaluated()</code> where available, <code>false</code> on C++17
+     * where nothing in this library is evaluated at compile time.
+     * */
+    constexpr auto is_constant_evaluated() noexcept -> bool
+    {
+#if KT_CONSTEXPR_VECTOR
+        return std::is_constant_evaluated();
+#else
+        return false;
+#endif
+    }
+
+} // namespace detail
+
+NAMESPACE_KT_END
+
 #endif //RESIZEABLE_ARRAY_COMMON_HH
@@ -0,0 +1,452 @@
+#ifndef CONCURRENT_VECTOR_HH
+#define CONCURRENT_VECTOR_HH
+
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+
+#include "common.hh"
+#include "allocator.hh"
+
+NAMESPACE_KT_BEG
+
+/**
+ * Append only vector that many threads can grow at the same time without locking.
+ * Elements live in segments of geometrically growing size (the segment <code>k</code> holds
+ * <code>first_segment_size << k</code> elements) which are never moved nor freed while the
+ * container is alive, so references and pointers to elements stay valid across appends.
+ *
+ * <p>Appending threads reserve their slots with a compare-and-swap on the element count,
+ * after making sure the segments holding them exist. The first thread reaching a segment
+ * that has not been allocated yet allocates it and publishes it with a compare-and-swap; a
+ * thread losing that race frees its block and uses the published one. A failed allocation
+ * therefore reserves nothing, and an element whose construction throws is replaced by a
+ * default constructed one, so every counted slot can always be destroyed.</p>
+ *
+ * <p><code>size()</code> counts reserved slots, some of which may still be under construction
+ * by other threads. Reading elements appended by other threads requires synchronizing with
+ * them first (e.g. joining them). <code>clear()</code> and destruction must not run concurrently
+ * with anything else.</p>
+ * */
+template <typename T, typename Alloc = allocator<T>>
+class concurrent_vector
+{
+    using alloc_traits          = std::allocator_traits<Alloc>;
+
+public:
+    using value_type            = T;
+    using allocator_type        = Alloc;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+    using const_reference_type  = const T&;
+
+    static constexpr size_type first_segment_size{ 8 };
+
+    template <bool Const>
+    class basic_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T*, T*>;
+        using reference         = std::conditional_t<Const, const T&, T&>;
+        using container_type    = std::conditional_t<Const, const concurrent_vector, concurrent_vector>;
+
+        basic_iterator() noexcept = default;
+
+        basic_iterator(container_type* items, size_type index) noexcept
+            :   m_items{ items }, m_index{ index }
+        {}
+
+        auto operator*() const -> reference { return (*this->m_items)[this->m_index]; }
+        auto operator->() const -> pointer { return &(*this->m_items)[this->m_index]; }
+
+        auto operator++() noexcept -> basic_iterator& { ++this->m_index; return *this; }
+        auto operator++(int) noexcept -> basic_iterator { basic_iterator copy{ *this }; ++this->m_index; return copy; }
+
+        auto operator==(const basic_iterator& other) const noexcept -> bool { return this->m_index == other.m_index; }
+        auto operator!=(const basic_iterator& other) const noexcept -> bool { return this->m_index != other.m_index; }
+
+    private:
+        container_type* m_items{ nullptr };
+        size_type       m_index{ 0 };
+    };
+
+    using iterator_type         = basic_iterator<false>;
+    using const_iterator_type   = basic_iterator<true>;
+
+    /**
+     * Constructs an empty vector, no segment is allocated until the first append.
+     * @param alloc allocator used for the segments of this vector
+     * */
+    explicit
+    concurrent_vector(const allocator_type& alloc = allocator_type()) noexcept
+        :   m_allocator{ alloc }
+    {
+        for (auto& segment : this->m_segments)
+            segment.store(nullptr, std::memory_order_relaxed);
+    }
+
+    concurrent_vector(const concurrent_vector&) = delete;
+    auto operator=(const concurrent_vector&) -> concurrent_vector& = delete;
+
+    /**
+     * Destroys every element and frees every segment.
+     * */
+    ~concurrent_vector()
+    {
+        clear();
+
+        for (size_type segment{}; segment < SEGMENT_COUNT; ++segment)
+        {
+            pointer_type block{ this->m_segments[segment].load(std::memory_order_relaxed) };
+
+            if (block != nullptr)
+                alloc_traits::deallocate(this->m_allocator, block, segment_size(segment));
+        }
+    }
+
+    /**
+     * Appends a copy of <code>value</code>. Safe to call from many threads at once.
+     * @param value value to be copied
+     * @returns reference to the new element, valid until the vector is cleared or destroyed
+     * @throws std::bad_alloc if a new segment cannot be allocated
+     * */
+    auto push_back(const value_type& value) -> reference_type
+    {
+        return emplace_back(value);
+    }
+
+    /**
+     * Appends <code>value</code> by moving it. Safe to call from many threads at once.
+     * @param value value to be moved
+     * @returns reference to the new element, valid until the vector is cleared or destroyed
+     * @throws std::bad_alloc if a new segment cannot be allocated
+     * */
+    auto push_back(value_type&& value) -> reference_type
+    {
+        return emplace_back(std::move(value));
+    }
+
+    /**
+     * Appends an element constructed in place from <code>args</code>. Safe to call from
+     * many threads at once.
+     * @param args arguments forwarded to the constructor of the element
+     * @returns reference to the new element, valid until the vector is cleared or destroyed
+     * @throws std::bad_alloc if a new segment cannot be allocated
+     * */
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> reference_type
+    {
+        return construct_at(claim(1), std::forward<Args>(args)...);
+    }
+
+    /**
+     * Appends <code>count</code> copies of <code>value</code> at consecutive indices.
+     * Safe to call from many threads at once.
+     * @param count amount of elements to append
+     * @param value value to be copied
+     * @returns index of the first appended element
+     * @throws std::bad_alloc if a new segment cannot be allocated
+     * */
+    auto grow_by(size_type count, const value_type& value = value_type()) -> size_type
+    {
+        const size_type first{ claim(count) };
+
+        if constexpr (std::is_nothrow_copy_constructible_v<T>)
+        {
+            for (size_type index{ first }; index < first + count; ++index)
+                construct_at(index, value);
+        }
+        else
+        {
+            size_type index{ first };
+
+            try
+            {
+                for (; index < first + count; ++index)
+                    construct_at(index, value);
+            }
+            catch (...)
+            {
+                // the failed slot was filled by construct_at, the ones after it are still raw
+                for (++index; index < first + count; ++index)
+                    construct_at(index);
+
+                throw;
+            }
+        }
+
+        return first;
+    }
+
+    /**
+     * Allocates the segments needed to hold <code>count</code> elements so that appends
+     * up to that size do not allocate. Safe to call concurrently with appends.
+     * @param count amount of elements to make room for
+     * @throws std::bad_alloc if a segment cannot be allocated
+     * */
+    auto reserve(size_type count) -> void
+    {
+        if (count == 0)
+            return;
+
+        const size_type last{ locate(count - 1).segment };
+
+        for (size_type segment{}; segment <= last; ++segment)
+            segment_at(segment);
+    }
+
+    /**
+     * Returns the amount of reserved slots, including elements still under construction.
+     * @returns amount of elements of this vector
+     * */
+    [[nodiscard]]
+    auto size() const noexcept -> size_type
+    {
+        return this->m_count.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Returns <code>true</code> if no element has been appended.
+     * @returns if this vector is empty or not
+     * */
+    [[nodiscard]]
+    auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /**
+     * Returns the amount of elements the allocated segments can hold.
+     * @returns capacity of this vector
+     * */
+    [[nodiscard]]
+    auto capacity() const noexcept -> size_type
+    {
+        size_type total{};
+
+        for (size_type segment{}; segment < SEGMENT_COUNT; ++segment)
+            if (this->m_segments[segment].load(std::memory_order_acquire) != nullptr)
+                total += segment_size(segment);
+
+        return total;
+    }
+
+    /**
+     * Returns a reference to the element at <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns reference to the element at the given index
+     * */
+    [[nodiscard]]
+    auto operator[](size_type index) -> reference_type
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        const auto position{ locate(index) };
+        return this->m_segments[position.segment].load(std::memory_order_acquire)[position.offset];
+    }
+
+    /**
+     * Returns a constant reference to the element at <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns reference to the element at the given index
+     * */
+    [[nodiscard]]
+    auto operator[](size_type index) const -> const_reference_type
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        const auto position{ locate(index) };
+        return this->m_segments[position.segment].load(std::memory_order_acquire)[position.offset];
+    }
+
+    /**
+     * Return reference to element at position <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns reference to the element at the given index
+     * @throws std::out_of_range if the index is out of bounds
+     * */
+    auto at(size_type index) -> reference_type
+    {
+        if (index >= size())
+            throw std::out_of_range("Attempting to access an element out of range");
+
+        return (*this)[index];
+    }
+
+    /**
+     * Return constant reference to element at position <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns constant reference to the element at the given index
+     * @throws std::out_of_range if the index is out of bounds
+     * */
+    auto at(size_type index) const -> const_reference_type
+    {
+        if (index >= size())
+            throw std::out_of_range("Attempting to access an element out of range");
+
+        return (*this)[index];
+    }
+
+    /**
+     * Destroys every element, the segments are kept for later appends.
+     * Must not run concurrently with any other operation.
+     * */
+    auto clear() -> void
+    {
+        const size_type count{ this->m_count.load(std::memory_order_relaxed) };
+
+        for (size_type index{}; index < count; ++index)
+            alloc_traits::destroy(this->m_allocator, &(*this)[index]);
+
+        this->m_count.store(0, std::memory_order_relaxed);
+    }
+
+    auto begin() noexcept -> iterator_type { return iterator_type{ this, 0 }; }
+    auto end() noexcept -> iterator_type { return iterator_type{ this, size() }; }
+    auto begin() const noexcept -> const_iterator_type { return const_iterator_type{ this, 0 }; }
+    auto end() const noexcept -> const_iterator_type { return const_iterator_type{ this, size() }; }
+    auto cbegin() const noexcept -> const_iterator_type { return begin(); }
+    auto cend() const noexcept -> const_iterator_type { return end(); }
+
+private:
+    static constexpr size_type FIRST_SEGMENT_BITS{ 3 };
+    static constexpr size_type SEGMENT_COUNT{ sizeof(size_type) * 8 - FIRST_SEGMENT_BITS };
+
+    static_assert(first_segment_size == size_type{ 1 } << FIRST_SEGMENT_BITS);
+
+    struct position_type
+    {
+        size_type segment;
+        size_type offset;
+    };
+
+    static constexpr auto segment_size(size_type segment) noexcept -> size_type
+    {
+        return first_segment_size << segment;
+    }
+
+    /**
+     * Maps an element index to its segment and its offset within the segment. Shifting the
+     * index by the first segment size makes every segment start at a power of two.
+     * */
+    static auto locate(size_type index) noexcept -> position_type
+    {
+        const size_type shifted{ index + first_segment_size };
+        const size_type high_bit{ highest_bit(shifted) };
+
+        return { high_bit - FIRST_SEGMENT_BITS, shifted - (size_type{ 1 } << high_bit) };
+    }
+
+    static auto highest_bit(size_type value) noexcept -> size_type
+    {
+#if defined(__GNUC__)
+        return sizeof(unsigned long long) * 8 - 1 - static_cast<size_type>(__builtin_clzll(value));
+#else
+        size_type bit{};
+        while (value >>= 1)
+            ++bit;
+        return bit;
+#endif
+    }
+
+    /**
+     * Returns the block of <code>segment</code>, allocating and publishing it if needed.
+     * */
+    auto segment_at(size_type segment) -> pointer_type
+    {
+        pointer_type block{ this->m_segments[segment].load(std::memory_order_acquire) };
+
+        if (block != nullptr)
+            return block;
+
+        pointer_type fresh{ alloc_traits::allocate(this->m_allocator, segment_size(segment)) };
+
+        if (fresh == nullptr)
+        {
+#if !defined(NDEBUG)
+            std::printf("could not allocate block of memory...");
+#endif
+            throw std::bad_alloc();
+        }
+
+        if (this->m_segments[segment].compare_exchange_strong(block, fresh, std::memory_order_acq_rel,
+                                                                std::memory_order_acquire))
+            return fresh;
+
+        // another thread published the segment first
+        alloc_traits::deallocate(this->m_allocator, fresh, segment_size(segment));
+        return block;
+    }
+
+    /**
+     * Reserves <code>count</code> consecutive slots and returns the index of the first one.
+     * Their segments are allocated before the count is bumped, so <code>size()</code> never
+     * covers a slot without storage; if an allocation throws nothing has been reserved.
+     * */
+    auto claim(size_type count) -> size_type
+    {
+        size_type first{ this->m_count.load(std::memory_order_relaxed) };
+
+        do
+        {
+            if (count != 0)
+            {
+                // the segments of the slots before first were allocated when those were claimed
+                const size_type last{ locate(first + count - 1).segment };
+
+                for (size_type segment{ locate(first).segment }; segment <= last; ++segment)
+                    segment_at(segment);
+            }
+        }
+        while (!this->m_count.compare_exchange_weak(first, first + count, std::memory_order_relaxed));
+
+        return first;
+    }
+
+    template <typename... Args>
+    auto construct_at(size_type index, Args&&... args) -> reference_type
+    {
+        // allocated by claim() before the slot was handed out
+        const auto position{ locate(index) };
+        pointer_type slot{ this->m_segments[position.segment].load(std::memory_order_acquire) + position.offset };
+
+        if constexpr (std::is_nothrow_constructible_v<T, Args...>)
+        {
+            alloc_traits::construct(this->m_allocator, slot, std::forward<Args>(args)...);
+        }
+        else
+        {
+            static_assert(std::is_nothrow_default_constructible_v<T>,
+                "elements whose construction may throw must be nothrow default constructible, "
+                "the reserved slot is filled with a default constructed element on failure");
+
+            try
+            {
+                alloc_traits::construct(this->m_allocator, slot, std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                // the slot cannot be given back, keep it destructible
+                alloc_traits::construct(this->m_allocator, slot);
+                throw;
+            }
+        }
+
+        return *slot;
+    }
+
+    // the count is the only contended word, keep it away from the segment table
+    alignas(cache_line_size) std::atomic<size_type>     m_count{ 0 };
+    alignas(cache_line_size) std::atomic<pointer_type>  m_segments[SEGMENT_COUNT];
+    allocator_type                                      m_allocator;
+};
+
+NAMESPACE_KT_END
+
+#endif // CONCURRENT_VECTOR_HH
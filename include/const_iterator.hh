@@ -3,82 +3,114 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <iterator>
 
+#include "iterator.hh"
+
+/**
+ * Random access iterator over a contiguous block of <code>const T</code>, see <code>iterator</code>.
+ * Every <code>iterator&lt;T&gt;</code> converts to it, and the two compare with each other.
+ * */
 template<typename T>
 class const_iterator
 {
 public:
-    using iterator_category = std::input_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept  = std::contiguous_iterator_tag;
+#endif
     using value_type = T;
     using difference_type = std::ptrdiff_t;
-    using pointer_type = T*;
+    using pointer = const T*;
+    using reference = const T&;
+    using pointer_type = const T*;
     using size_type             = std::size_t;
     using const_reference_type  = const T&;
 
-    explicit const_iterator(pointer_type ptr)
+    constexpr const_iterator() noexcept = default;
+
+    constexpr explicit const_iterator(pointer_type ptr) noexcept
         :   p{ ptr }
     {}
 
+    constexpr const_iterator(const iterator<T>& other) noexcept
+        :   p{ other.raw() }
+    {}
+
     // prefix increment
-    auto operator++() -> const_iterator
+    constexpr auto operator++() noexcept -> const_iterator&
     {
         ++p;
         return *this;
     }
 
     // postfix increment
-    auto operator++(int) -> const_iterator
+    constexpr auto operator++(int) noexcept -> const_iterator
     {
         auto res{ p };
         ++p;
         return const_iterator{ res };
     }
 
-    // prefix increment
-    auto operator--() -> const_iterator
+    // prefix decrement
+    constexpr auto operator--() noexcept -> const_iterator&
     {
         --p;
         return *this;
     }
 
-    // postfix increment
-    auto operator--(int) -> const_iterator
+    // postfix decrement
+    constexpr auto operator--(int) noexcept -> const_iterator
     {
         auto res{ p };
         --p;
         return const_iterator{ res };
     }
 
-    auto operator+(size_type count) const -> const_iterator
+    constexpr auto operator+=(difference_type count) noexcept -> const_iterator&
     {
-        return const_iterator{ this->p + count };
+        this->p += count;
+        return *this;
     }
 
-    auto operator-(size_type count) const -> const_iterator
+    constexpr auto operator-=(difference_type count) noexcept -> const_iterator&
     {
-        return const_iterator{ this->p - count };
+        this->p -= count;
+        return *this;
+    }
+
+    constexpr auto operator+(difference_type count) const noexcept -> const_iterator
+    {
+        return const_iterator{ this->p + count };
     }
 
-    auto operator-(const_iterator other) -> size_type
+    constexpr friend auto operator+(difference_type count, const const_iterator& it) noexcept -> const_iterator
     {
-        return this->p > other.p ?
-               (this->p - other.p) : (other.p - this->p);
+        return const_iterator{ it.p + count };
     }
 
-    auto operator!=(const const_iterator& other) const -> bool
+    constexpr auto operator-(difference_type count) const noexcept -> const_iterator
     {
-        return this->p != other.p;
+        return const_iterator{ this->p - count };
     }
 
-    auto operator==(const const_iterator& other) const -> bool
+    constexpr friend auto operator-(const const_iterator& lhs, const const_iterator& rhs) noexcept -> difference_type
     {
-        return this->p == other.p;
+        return lhs.p - rhs.p;
     }
 
-    auto operator*() const -> const_reference_type { return *p; }
-    auto operator->() const -> pointer_type { return p; }
+    constexpr friend auto operator==(const const_iterator& lhs, const const_iterator& rhs) noexcept -> bool { return lhs.p == rhs.p; }
+    constexpr friend auto operator!=(const const_iterator& lhs, const const_iterator& rhs) noexcept -> bool { return lhs.p != rhs.p; }
+    constexpr friend auto operator<(const const_iterator& lhs, const const_iterator& rhs) noexcept -> bool { return lhs.p < rhs.p; }
+    constexpr friend auto operator>(const const_iterator& lhs, const const_iterator& rhs) noexcept -> bool { return lhs.p > rhs.p; }
+    constexpr friend auto operator<=(const const_iterator& lhs, const const_iterator& rhs) noexcept -> bool { return lhs.p <= rhs.p; }
+    constexpr friend auto operator>=(const const_iterator& lhs, const const_iterator& rhs) noexcept -> bool { return lhs.p >= rhs.p; }
+
+    constexpr auto operator*() const noexcept -> const_reference_type { return *p; }
+    constexpr auto operator->() const noexcept -> pointer_type { return p; }
+    constexpr auto operator[](difference_type index) const noexcept -> const_reference_type { return p[index]; }
 
-    auto raw() const -> pointer_type { return p; }
+    constexpr auto raw() const noexcept -> pointer_type { return p; }
 
 private:
     pointer_type p{};
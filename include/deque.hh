@@ -0,0 +1,31 @@
+#ifndef DEQUE_HH
+#define DEQUE_HH
+
+#include "common.hh"
+#include "ring_buffer.hh"
+
+NAMESPACE_KT_BEG
+
+/**
+ * Double ended queue: a <code>ring_buffer</code> that can also grow at the front and shrink at
+ * the back, every end operation in amortized O(1). Unlike <code>std::deque</code> the elements
+ * live in a single block, so they are at most two contiguous runs (see <code>spans()</code>), and
+ * references are invalidated when the capacity doubles.
+ * @tparam T type of the elements, its moves must not throw unless it is trivially relocatable
+ * @tparam Alloc allocator providing the storage
+ * */
+template <typename T, typename Alloc = allocator<T>>
+class deque : public ring_buffer<T, Alloc>
+{
+public:
+    using ring_buffer<T, Alloc>::ring_buffer;
+
+    using ring_buffer<T, Alloc>::emplace_front;
+    using ring_buffer<T, Alloc>::push_front;
+    using ring_buffer<T, Alloc>::pop_back;
+    using ring_buffer<T, Alloc>::pop_back_n;
+};
+
+NAMESPACE_KT_END
+
+#endif // DEQUE_HH
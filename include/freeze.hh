@@ -0,0 +1,54 @@
+#ifndef FREEZE_HH
+#define FREEZE_HH
+
+#include <array>
+
+#include "common.hh"
+#include "vector.hh"
+
+#if !KT_CONSTEXPR_VECTOR
+    #error "kt::freeze requires C++20 constexpr dynamic allocation"
+#endif
+
+NAMESPACE_KT_BEG
+
+/**
+ * Runs <code>make</code>, a captureless lambda returning a <code>kt::vector</code>, at compile time
+ * and copies the elements it produced into a <code>std::array</code> of exactly that size. The vector
+ * cannot leave constant evaluation (its buffer is transient), the array can, so a table declared as
+ *
+ * <pre>
+ * static constexpr auto squares{ kt::freeze([] {
+ *     kt::vector<int> table{};
+ *     for (int index{}; index < 256; ++index)
+ *         table.push_back(index * index);
+ *     return table;
+ * }) };
+ * </pre>
+ *
+ * is computed by the compiler and stored in read only data, costing nothing at startup.
+ * <code>make</code> runs twice, once to learn the size, so it must give the same result each time.
+ * @param make lambda building the table, must not capture anything
+ * @returns the elements built by <code>make</code>
+ * @tparam Make type of the lambda, default constructible since it has no captures
+ * */
+template <typename Make>
+consteval auto freeze(Make make)
+{
+    using vector_type = decltype(make());
+    using value_type = typename vector_type::value_type;
+
+    static_assert(std::is_default_constructible_v<value_type>, "frozen elements must be default constructible");
+
+    constexpr std::size_t count{ Make{}().size() };
+
+    const vector_type built{ make() };
+    std::array<value_type, count> table{};
+    std::copy(built.begin(), built.end(), table.begin());
+
+    return table;
+}
+
+NAMESPACE_KT_END
+
+#endif // FREEZE_HH
@@ -0,0 +1,218 @@
+#ifndef GROWTH_HH
+#define GROWTH_HH
+
+#include "common.hh"
+
+NAMESPACE_KT_BEG
+
+/**
+ * Growth policies decide how much storage a vector requests every time it runs out
+ * of capacity. A policy provides:
+ * <ul>
+ * <li><code>next_capacity(capacity, required, element_size)</code>: capacity to grow to when
+ * <code>required</code> elements no longer fit in <code>capacity</code></li>
+ * <li><code>round_capacity(count, element_size)</code>: adjusts every allocation request,
+ * including the exact ones made by <code>reserve()</code></li>
+ * <li><code>use_usable_size</code>: if <code>true</code> and the allocator can report the real size
+ * of a block (<code>usable_size(pointer, count)</code>), the vector adopts it as its capacity</li>
+ * <li><code>shrinks</code> and <code>shrink_capacity(capacity, size, element_size)</code>: if <code>shrinks</code>
+ * is <code>true</code> the vector asks for the capacity to keep every time it loses elements and
+ * reallocates when the answer is smaller than its capacity</li>
+ * </ul>
+ * <code>policy_base</code> provides defaults for everything but <code>next_capacity</code>.
+ * */
+namespace growth {
+
+    using size_type = std::size_t;
+
+    /**
+     * Defaults shared by every policy: allocation requests are left as they are
+     * and the capacity is the requested one.
+     * */
+    struct policy_base
+    {
+        static constexpr bool use_usable_size{ false };
+        static constexpr bool shrinks{ false };
+
+        static constexpr auto round_capacity(size_type count, size_type) noexcept -> size_type
+        {
+            return count;
+        }
+
+        static constexpr auto shrink_capacity(size_type capacity, size_type, size_type) noexcept -> size_type
+        {
+            return capacity;
+        }
+    };
+
+    /**
+     * Doubles the capacity on every reallocation, starting at one element.
+     * Fewest reallocations, up to 50% of the block unused.
+     * */
+    struct doubling : policy_base
+    {
+        static constexpr auto next_capacity(size_type capacity, size_type required, size_type) noexcept -> size_type
+        {
+            return std::max(required, capacity == 0 ? size_type{ 1 } : capacity * 2);
+        }
+    };
+
+    /**
+     * Grows the capacity by half on every reallocation. Less memory left unused at
+     * the expense of more reallocations, freed blocks can also be reused by later growth.
+     * */
+    struct one_and_half : policy_base
+    {
+        static constexpr auto next_capacity(size_type capacity, size_type required, size_type) noexcept -> size_type
+        {
+            return std::max(required, capacity + (capacity + 1) / 2);
+        }
+    };
+
+    /**
+     * Uses <code>First</code> as the capacity of the first allocation and defers
+     * to <code>Base</code> afterwards. Skips the 1, 2, 4... reallocations of vectors
+     * whose typical size is known up front.
+     * @tparam First capacity of the first block
+     * @tparam Base policy used for every subsequent reallocation
+     * */
+    template <size_type First, typename Base = doubling>
+    struct first_capacity : Base
+    {
+        static_assert(First > 0, "the first capacity must be greater than zero");
+
+        static constexpr auto next_capacity(size_type capacity, size_type required, size_type element_size) noexcept -> size_type
+        {
+            return capacity == 0 ? std::max(required, First) : Base::next_capacity(capacity, required, element_size);
+        }
+    };
+
+    /**
+     * Rounds every request made by <code>Base</code> up to the size classes used by
+     * common malloc implementations (16 byte steps for small blocks, then four classes
+     * per power of two, whole pages for large ones) and adopts the usable size reported
+     * by the allocator, so the slack the allocator would waste anyway becomes capacity.
+     * @tparam Base policy deciding the growth before rounding
+     * */
+    template <typename Base = doubling>
+    struct size_class : Base
+    {
+        static constexpr bool use_usable_size{ true };
+
+        static constexpr auto next_capacity(size_type capacity, size_type required, size_type element_size) noexcept -> size_type
+        {
+            return Base::next_capacity(capacity, required, element_size);
+        }
+
+        static constexpr auto round_capacity(size_type count, size_type element_size) noexcept -> size_type
+        {
+            count = Base::round_capacity(count, element_size);
+            return round_bytes(count * element_size) / element_size;
+        }
+
+        /**
+         * Returns the size class <code>bytes</code> falls in.
+         * */
+        static constexpr auto round_bytes(size_type bytes) noexcept -> size_type
+        {
+            constexpr size_type QUANTUM{ 16 };
+            constexpr size_type SMALL_LIMIT{ 128 };
+            constexpr size_type PAGE_SIZE{ 4096 };
+
+            if (bytes <= SMALL_LIMIT)
+                return round_up(std::max(bytes, QUANTUM), QUANTUM);
+
+            if (bytes >= PAGE_SIZE * 4)
+                return round_up(bytes, PAGE_SIZE);
+
+            // four classes between consecutive powers of two
+            size_type power{ SMALL_LIMIT };
+            while (power * 2 < bytes)
+                power *= 2;
+
+            return round_up(bytes, power / 4);
+        }
+
+    private:
+        static constexpr auto round_up(size_type value, size_type multiple) noexcept -> size_type
+        {
+            return (value + multiple - 1) / multiple * multiple;
+        }
+    };
+
+    /**
+     * Rounds every request made by <code>Base</code> up so that the buffer spans a whole
+     * number of <code>Bytes</code> sized chunks, e.g. vector registers. SIMD kernels can then
+     * process the padding lanes along with the elements instead of running a scalar tail.
+     * @tparam Bytes chunk size in bytes, usually the width of a vector register
+     * @tparam Base policy deciding the growth before rounding
+     * */
+    template <size_type Bytes, typename Base = doubling>
+    struct padded : Base
+    {
+        static_assert(Bytes > 0, "the padding must be greater than zero");
+
+        static constexpr auto next_capacity(size_type capacity, size_type required, size_type element_size) noexcept -> size_type
+        {
+            return Base::next_capacity(capacity, required, element_size);
+        }
+
+        static constexpr auto round_capacity(size_type count, size_type element_size) noexcept -> size_type
+        {
+            count = Base::round_capacity(count, element_size);
+
+            const size_type bytes{ (count * element_size + Bytes - 1) / Bytes * Bytes };
+            return std::max(count, bytes / element_size);
+        }
+    };
+
+    /**
+     * Grows like <code>Base</code> and gives memory back once the vector has shrunk to a
+     * <code>Ratio</code>th of its capacity, keeping twice its size. The gap between the shrink
+     * point and the new capacity is the hysteresis: a vector oscillating around some size does
+     * not reallocate on every push and pop. Buffers of at most <code>MinBytes</code> are never
+     * shrunk, so clearing and refilling small vectors does not allocate.
+     * @tparam Base policy deciding the growth
+     * @tparam Ratio how many times the capacity must exceed the size before shrinking, at least 3
+     * @tparam MinBytes size of the buffers left alone
+     * */
+    template <typename Base = doubling, size_type Ratio = 4, size_type MinBytes = 4096>
+    struct shrinking : Base
+    {
+        static_assert(Ratio > 2, "shrinking to twice the size must leave room to grow before the next shrink");
+
+        static constexpr bool shrinks{ true };
+
+        static constexpr auto shrink_capacity(size_type capacity, size_type size, size_type element_size) noexcept -> size_type
+        {
+            if (capacity * element_size <= MinBytes || size * Ratio > capacity)
+                return capacity;
+
+            return std::max(size * 2, MinBytes / element_size);
+        }
+    };
+
+} // namespace growth
+
+namespace detail {
+
+    /**
+     * Detects allocators able to report how many objects fit in a block they handed
+     * out, through <code>usable_size(pointer, requested_count)</code>.
+     * */
+    template <typename Alloc, typename = void>
+    struct has_usable_size : std::false_type {};
+
+    template <typename Alloc>
+    struct has_usable_size<Alloc, std::void_t<decltype(std::declval<const Alloc&>().usable_size(
+        std::declval<typename std::allocator_traits<Alloc>::pointer>(),
+        std::declval<typename std::allocator_traits<Alloc>::size_type>()))>> : std::true_type {};
+
+    template <typename Alloc>
+    inline constexpr bool has_usable_size_v = has_usable_size<Alloc>::value;
+
+} // namespace detail
+
+NAMESPACE_KT_END
+
+#endif // GROWTH_HH
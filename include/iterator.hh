@@ -3,80 +3,107 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <iterator>
 
+/**
+ * Random access iterator over a contiguous block of <code>T</code>, so standard algorithms
+ * compute distances in constant time. Under C++20 it also declares the contiguous
+ * <code>iterator_concept</code>.
+ * */
 template<typename T>
 class iterator
 {
 public:
-    using iterator_category = std::input_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept  = std::contiguous_iterator_tag;
+#endif
     using value_type = T;
     using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
     using pointer_type = T*;
     using size_type             = std::size_t;
     using reference_type        = T&;
 
-    explicit iterator(pointer_type ptr) : p{ ptr } { }
+    constexpr iterator() noexcept = default;
+
+    constexpr explicit iterator(pointer_type ptr) noexcept : p{ ptr } { }
 
     // prefix increment
-    auto operator++() -> iterator
+    constexpr auto operator++() noexcept -> iterator&
     {
         ++p;
         return *this;
     }
 
     // postfix increment
-    auto operator++(int) -> iterator
+    constexpr auto operator++(int) noexcept -> iterator
     {
         auto res{ p };
         ++p;
         return iterator{ res };
     }
 
-    // prefix increment
-    auto operator--() -> iterator
+    // prefix decrement
+    constexpr auto operator--() noexcept -> iterator&
     {
         --p;
         return *this;
     }
 
-    // postfix increment
-    auto operator--(int) -> iterator
+    // postfix decrement
+    constexpr auto operator--(int) noexcept -> iterator
     {
         auto res{ p };
         --p;
         return iterator{ res };
     }
 
-    auto operator+(size_type count) -> iterator
+    constexpr auto operator+=(difference_type count) noexcept -> iterator&
     {
-        return iterator{ this->p + count };
+        this->p += count;
+        return *this;
     }
 
-    auto operator-(size_type count) -> iterator
+    constexpr auto operator-=(difference_type count) noexcept -> iterator&
     {
-        return iterator{ this->p - count };
+        this->p -= count;
+        return *this;
     }
 
-    auto operator-(iterator other) -> size_type
+    constexpr auto operator+(difference_type count) const noexcept -> iterator
     {
-        return this->p > other.p ?
-               (this->p - other.p) : (other.p - this->p);
+        return iterator{ this->p + count };
+    }
+
+    constexpr friend auto operator+(difference_type count, const iterator& it) noexcept -> iterator
+    {
+        return iterator{ it.p + count };
     }
 
-    auto operator!=(const iterator& other) -> bool
+    constexpr auto operator-(difference_type count) const noexcept -> iterator
     {
-        return this->p != other.p;
+        return iterator{ this->p - count };
     }
 
-    auto operator==(const iterator& other) -> bool
+    constexpr friend auto operator-(const iterator& lhs, const iterator& rhs) noexcept -> difference_type
     {
-        return this->p == other.p;
+        return lhs.p - rhs.p;
     }
 
-    auto operator*() -> reference_type { return *p; }
-    auto operator->() -> pointer_type { return p; }
+    constexpr friend auto operator==(const iterator& lhs, const iterator& rhs) noexcept -> bool { return lhs.p == rhs.p; }
+    constexpr friend auto operator!=(const iterator& lhs, const iterator& rhs) noexcept -> bool { return lhs.p != rhs.p; }
+    constexpr friend auto operator<(const iterator& lhs, const iterator& rhs) noexcept -> bool { return lhs.p < rhs.p; }
+    constexpr friend auto operator>(const iterator& lhs, const iterator& rhs) noexcept -> bool { return lhs.p > rhs.p; }
+    constexpr friend auto operator<=(const iterator& lhs, const iterator& rhs) noexcept -> bool { return lhs.p <= rhs.p; }
+    constexpr friend auto operator>=(const iterator& lhs, const iterator& rhs) noexcept -> bool { return lhs.p >= rhs.p; }
+
+    constexpr auto operator*() const noexcept -> reference_type { return *p; }
+    constexpr auto operator->() const noexcept -> pointer_type { return p; }
+    constexpr auto operator[](difference_type index) const noexcept -> reference_type { return p[index]; }
 
-    auto raw() const -> pointer_type { return p; }
+    constexpr auto raw() const noexcept -> pointer_type { return p; }
 
 private:
     pointer_type p{};
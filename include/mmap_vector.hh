@@ -0,0 +1,455 @@
+#ifndef MMAP_VECTOR_HH
+#define MMAP_VECTOR_HH
+
+#include <cstdio>
+#include <stdexcept>
+
+#include "common.hh"
+#include "growth.hh"
+#include "allocator.hh"
+#include "iterator.hh"
+#include "const_iterator.hh"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+    #error "kt::mmap_vector requires a POSIX system"
+#endif
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+NAMESPACE_KT_BEG
+
+/**
+ * Vector of trivially copyable elements stored in a memory mapped file. The elements are
+ * the file contents, so a table built once can be opened again, by this or any other process,
+ * without reading nor deserializing anything: pages are loaded lazily on first access and
+ * shared between every process mapping the same file.
+ *
+ * <p>The file starts with a 64 byte header (magic, format version, element size and element
+ * count) followed by the elements. Growing the vector extends the file with <code>ftruncate()</code>
+ * and remaps it, with <code>mremap()</code> on Linux. Like <code>kt::vector</code>, growth invalidates
+ * pointers and iterators to the elements.</p>
+ *
+ * <p>Errors are reported the same way as in the rest of the library: a vector that could not open or
+ * map its file is left closed (see <code>is_open()</code>) and operations that cannot be completed
+ * have no effect. Mutating a vector opened with <code>open_mode::read_only</code> has no effect either.</p>
+ * @tparam T type of the elements, must be trivially copyable
+ * @tparam Growth policy deciding the capacity the file grows to
+ * */
+template <typename T, typename Growth = growth::doubling>
+class mmap_vector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "mmap_vector elements are stored as raw bytes in a file");
+    static_assert(alignof(T) <= 64, "mmap_vector elements must not be aligned beyond the file header size");
+
+public:
+    using value_type            = T;
+    using growth_policy         = Growth;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+    using const_reference_type  = const T&;
+    using iterator_type         = iterator<T>;
+    using const_iterator_type   = const_iterator<T>;
+
+    enum class open_mode
+    {
+        read_only,      // maps an existing file, every mutation is ignored
+        read_write,     // maps an existing file or creates an empty one
+        truncate        // discards the contents of an existing file or creates an empty one
+    };
+
+    /**
+     * Opens or creates the file at <code>path</code> and maps its elements.
+     * @param path location of the file backing this vector
+     * @param mode how the file is opened
+     * */
+    explicit
+    mmap_vector(const char* path, open_mode mode = open_mode::read_write)
+        :   m_mode{ mode }
+    {
+        open(path);
+    }
+
+    mmap_vector(const mmap_vector&) = delete;
+    auto operator=(const mmap_vector&) -> mmap_vector& = delete;
+
+    mmap_vector(mmap_vector&& other) noexcept
+        :   m_mode{ other.m_mode }, m_descriptor{ other.m_descriptor }, m_header{ other.m_header }
+        ,   m_capacity{ other.m_capacity }
+    {
+        other.m_descriptor = -1;
+        other.m_header = nullptr;
+        other.m_capacity = 0;
+    }
+
+    auto operator=(mmap_vector&& other) noexcept -> mmap_vector&
+    {
+        if (this != &other)
+        {
+            close();
+
+            this->m_mode = other.m_mode;
+            this->m_descriptor = std::exchange(other.m_descriptor, -1);
+            this->m_header = std::exchange(other.m_header, nullptr);
+            this->m_capacity = std::exchange(other.m_capacity, 0);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Unmaps the file and closes it, the elements stay in the file.
+     * */
+    ~mmap_vector()
+    {
+        close();
+    }
+
+    /**
+     * Returns <code>true</code> if the file was opened and mapped successfully.
+     * @returns if this vector is backed by a file
+     * */
+    [[nodiscard]]
+    auto is_open() const noexcept -> bool
+    {
+        return this->m_header != nullptr;
+    }
+
+    /**
+     * Returns <code>true</code> if this vector accepts modifications.
+     * @returns if this vector is writable
+     * */
+    [[nodiscard]]
+    auto is_writable() const noexcept -> bool
+    {
+        return is_open() && this->m_mode != open_mode::read_only;
+    }
+
+    /**
+     * Flushes the modified pages to the file. Not needed for other processes mapping
+     * the file to see the changes, only to make them durable before returning.
+     * @returns <code>true</code> on success
+     * */
+    auto sync() noexcept -> bool
+    {
+        return is_open() && ::msync(static_cast<void*>(this->m_header), mapping_size(this->m_capacity), MS_SYNC) == 0;
+    }
+
+    /**
+     * Unmaps and closes the file, after which this vector is empty and closed.
+     * */
+    auto close() noexcept -> void
+    {
+        if (this->m_header != nullptr)
+            ::munmap(static_cast<void*>(this->m_header), mapping_size(this->m_capacity));
+
+        if (this->m_descriptor != -1)
+            ::close(this->m_descriptor);
+
+        this->m_header = nullptr;
+        this->m_descriptor = -1;
+        this->m_capacity = 0;
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> size_type
+    {
+        return is_open() ? static_cast<size_type>(this->m_header->count) : 0;
+    }
+
+    [[nodiscard]]
+    auto capacity() const noexcept -> size_type
+    {
+        return this->m_capacity;
+    }
+
+    [[nodiscard]]
+    auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    auto data() noexcept -> pointer_type
+    {
+        return elements();
+    }
+
+    auto data() const noexcept -> const T*
+    {
+        return elements();
+    }
+
+    [[nodiscard]]
+    auto operator[](size_type index) -> reference_type
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        return elements()[index];
+    }
+
+    [[nodiscard]]
+    auto operator[](size_type index) const -> const_reference_type
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        return elements()[index];
+    }
+
+    /**
+     * Return reference to element at position <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns reference to the element at the given index
+     * @throws std::out_of_range if the index is out of bounds
+     * */
+    auto at(size_type index) -> reference_type
+    {
+        if (index >= size())
+            throw std::out_of_range("Attempting to access an element out of range");
+
+        return elements()[index];
+    }
+
+    auto at(size_type index) const -> const_reference_type
+    {
+        if (index >= size())
+            throw std::out_of_range("Attempting to access an element out of range");
+
+        return elements()[index];
+    }
+
+    auto front() -> reference_type { return (*this)[0]; }
+    auto front() const -> const_reference_type { return (*this)[0]; }
+    auto back() -> reference_type { return (*this)[size() - 1]; }
+    auto back() const -> const_reference_type { return (*this)[size() - 1]; }
+
+    /**
+     * Grows the file so that it can hold at least <code>new_count</code> elements.
+     * @param new_count amount of elements to make room for
+     * */
+    auto reserve(size_type new_count) -> void
+    {
+        if (new_count > capacity())
+            remap(new_count);
+    }
+
+    /**
+     * Changes the number of elements to <code>count</code>, new elements are copies of <code>value</code>.
+     * @param count number of elements this vector must hold
+     * @param value the additional elements are copied from
+     * */
+    auto resize(size_type count, const value_type& value = value_type()) -> void
+    {
+        if (!is_writable())
+            return;
+
+        if (count > capacity() && !remap(std::max(count, growth_policy::next_capacity(capacity(), count, sizeof(T)))))
+            return;
+
+        for (size_type index{ size() }; index < count; ++index)
+            elements()[index] = value;
+
+        this->m_header->count = count;
+    }
+
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> void
+    {
+        if (!is_writable())
+            return;
+
+        if (size() == capacity() && !remap(growth_policy::next_capacity(capacity(), size() + 1, sizeof(T))))
+        {
+#if !defined(NDEBUG)
+            std::printf("could not insert new element due to error while reallocating...");
+#endif
+            return;
+        }
+
+        ::new (static_cast<void*>(elements() + size())) value_type(std::forward<Args>(args)...);
+        ++this->m_header->count;
+    }
+
+    auto push_back(const_reference_type elem) -> void
+    {
+        emplace_back(elem);
+    }
+
+    auto pop_back() noexcept -> void
+    {
+        if (is_writable() && !empty())
+            --this->m_header->count;
+    }
+
+    /**
+     * Removes every element, the file keeps its capacity.
+     * */
+    auto clear() noexcept -> void
+    {
+        if (is_writable())
+            this->m_header->count = 0;
+    }
+
+    auto begin() noexcept -> iterator_type { return iterator_type{ elements() }; }
+    auto end() noexcept -> iterator_type { return iterator_type{ elements() + size() }; }
+    auto begin() const noexcept -> const_iterator_type { return const_iterator_type{ elements() }; }
+    auto end() const noexcept -> const_iterator_type { return const_iterator_type{ elements() + size() }; }
+    auto cbegin() const noexcept -> const_iterator_type { return begin(); }
+    auto cend() const noexcept -> const_iterator_type { return end(); }
+
+private:
+    static constexpr std::uint32_t FORMAT_VERSION{ 1 };
+
+    struct alignas(64) file_header
+    {
+        char            magic[8];
+        std::uint32_t   version;
+        std::uint32_t   element_size;
+        std::uint64_t   count;
+    };
+
+    static_assert(sizeof(file_header) == 64);
+
+    static constexpr char MAGIC[8]{ 'K', 'T', 'M', 'M', 'V', 'E', 'C', '\0' };
+
+    static auto mapping_size(size_type count) noexcept -> size_type
+    {
+        return detail::round_to_pages(sizeof(file_header) + count * sizeof(T));
+    }
+
+    static auto capacity_of(size_type bytes) noexcept -> size_type
+    {
+        return (bytes - sizeof(file_header)) / sizeof(T);
+    }
+
+    auto elements() const noexcept -> pointer_type
+    {
+        return this->m_header != nullptr ? reinterpret_cast<pointer_type>(this->m_header + 1) : nullptr;
+    }
+
+    auto protection() const noexcept -> int
+    {
+        return this->m_mode == open_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    }
+
+    auto fail(const char* message) noexcept -> void
+    {
+#if !defined(NDEBUG)
+        std::printf("%s", message);
+#else
+        static_cast<void>(message);
+#endif
+        close();
+    }
+
+    auto open(const char* path) noexcept -> void
+    {
+        const int flags{ this->m_mode == open_mode::read_only ? O_RDONLY :
+                         this->m_mode == open_mode::truncate ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR | O_CREAT };
+
+        this->m_descriptor = ::open(path, flags | O_CLOEXEC, 0644);
+
+        if (this->m_descriptor == -1)
+            return fail("could not open the file backing the vector...");
+
+        struct stat status{};
+        if (::fstat(this->m_descriptor, &status) != 0)
+            return fail("could not query the file backing the vector...");
+
+        size_type bytes{ static_cast<size_type>(status.st_size) };
+        const bool fresh{ bytes == 0 };
+
+        if (fresh)
+        {
+            if (this->m_mode == open_mode::read_only)
+                return fail("the file backing the read only vector is empty...");
+
+            bytes = mapping_size(0);
+
+            if (::ftruncate(this->m_descriptor, static_cast<off_t>(bytes)) != 0)
+                return fail("could not size the file backing the vector...");
+        }
+
+        if (bytes < sizeof(file_header))
+            return fail("the file backing the vector is not a vector file...");
+
+        void* mapping{ ::mmap(nullptr, bytes, protection(), MAP_SHARED, this->m_descriptor, 0) };
+
+        if (mapping == MAP_FAILED)
+            return fail("could not map the file backing the vector...");
+
+        this->m_header = static_cast<file_header*>(mapping);
+        this->m_capacity = capacity_of(bytes);
+
+        if (fresh)
+        {
+            std::memcpy(this->m_header->magic, MAGIC, sizeof(MAGIC));
+            this->m_header->version = FORMAT_VERSION;
+            this->m_header->element_size = static_cast<std::uint32_t>(sizeof(T));
+            this->m_header->count = 0;
+        }
+        else if (std::memcmp(this->m_header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+                 this->m_header->version != FORMAT_VERSION ||
+                 this->m_header->element_size != sizeof(T) ||
+                 this->m_header->count > this->m_capacity)
+        {
+            return fail("the file backing the vector holds a different kind of vector...");
+        }
+    }
+
+    /**
+     * Extends the file to hold <code>new_count</code> elements and maps the new size.
+     * On failure the vector is left untouched.
+     * */
+    auto remap(size_type new_count) noexcept -> bool
+    {
+        if (!is_writable())
+            return false;
+
+        const size_type old_bytes{ mapping_size(this->m_capacity) };
+        const size_type new_bytes{ mapping_size(new_count) };
+
+        if (::ftruncate(this->m_descriptor, static_cast<off_t>(new_bytes)) != 0)
+        {
+#if !defined(NDEBUG)
+            std::printf("could not grow the file backing the vector...");
+#endif
+            return false;
+        }
+
+#if defined(__linux__)
+        void* mapping{ ::mremap(static_cast<void*>(this->m_header), old_bytes, new_bytes, MREMAP_MAYMOVE) };
+#else
+        void* mapping{ ::mmap(nullptr, new_bytes, protection(), MAP_SHARED, this->m_descriptor, 0) };
+
+        if (mapping != MAP_FAILED)
+            ::munmap(static_cast<void*>(this->m_header), old_bytes);
+#endif
+
+        if (mapping == MAP_FAILED)
+        {
+#if !defined(NDEBUG)
+            std::printf("could not map the grown file backing the vector...");
+#endif
+            return false;
+        }
+
+        this->m_header = static_cast<file_header*>(mapping);
+        this->m_capacity = capacity_of(new_bytes);
+
+        return true;
+    }
+
+    open_mode       m_mode;
+    int             m_descriptor{ -1 };
+    file_header*    m_header{ nullptr };
+    size_type       m_capacity{ 0 };
+};
+
+NAMESPACE_KT_END
+
+#endif // MMAP_VECTOR_HH
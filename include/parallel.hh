@@ -0,0 +1,279 @@
+#ifndef PARALLEL_HH
+#define PARALLEL_HH
+
+#include <new>
+#include <functional>
+
+#include "common.hh"
+#include "vector.hh"
+#include "thread_pool.hh"
+
+NAMESPACE_KT_BEG
+
+/**
+ * Data parallel algorithms over contiguous ranges and <code>kt::vector</code>. Ranges are cut
+ * into chunks of <code>grain_size</code> elements which run as tasks on a <code>kt::thread_pool</code>
+ * (the process wide <code>thread_pool::default_pool()</code> unless one is given). The calling
+ * thread processes the first chunk itself and helps with the rest while waiting.
+ *
+ * <p>A <code>grain_size</code> of <code>automatic_grain</code> picks enough chunks to keep every
+ * worker busy without making them smaller than <code>minimum_grain</code> elements. Use smaller
+ * grains for expensive per-element work and larger ones for cheap loops.</p>
+ * */
+namespace parallel {
+
+    using size_type = std::size_t;
+
+    inline constexpr size_type automatic_grain{ 0 };
+    inline constexpr size_type minimum_grain{ 2048 };
+
+    namespace detail {
+
+        inline auto resolve_grain(size_type count, size_type grain, const thread_pool& pool) noexcept -> size_type
+        {
+            if (grain != automatic_grain)
+                return grain;
+
+            // a few chunks per worker leave room for stealing when chunks take uneven time
+            constexpr size_type CHUNKS_PER_WORKER{ 4 };
+            return std::max(minimum_grain, count / (pool.size() * CHUNKS_PER_WORKER) + 1);
+        }
+
+        /**
+         * Calls <code>body(begin, end)</code> for consecutive index ranges covering [0, count).
+         * */
+        template <typename Body>
+        auto for_chunks(size_type count, size_type grain, thread_pool& pool, Body&& body) -> void
+        {
+            if (count == 0)
+                return;
+
+            grain = resolve_grain(count, grain, pool);
+
+            if (count <= grain)
+                return body(size_type{ 0 }, count);
+
+            task_group group{ pool };
+
+            for (size_type begin{ grain }; begin < count; begin += grain)
+            {
+                const size_type end{ std::min(count, begin + grain) };
+                group.run([&body, begin, end]() -> void { body(begin, end); });
+            }
+
+            try
+            {
+                body(size_type{ 0 }, grain);
+            }
+            catch (...)
+            {
+                group.wait();
+                throw;
+            }
+
+            group.wait();
+        }
+
+    } // namespace detail
+
+    /**
+     * Calls <code>function</code> on every element of [first, last) in parallel.
+     * @param first beginning of the range
+     * @param last end of the range
+     * @param function callable taking a reference to an element
+     * @param grain_size number of elements handled by each task
+     * @param pool pool running the tasks
+     * */
+    template <typename T, typename Function>
+    auto for_each(T* first, T* last, Function function, size_type grain_size = automatic_grain,
+                  thread_pool& pool = thread_pool::default_pool()) -> void
+    {
+        detail::for_chunks(static_cast<size_type>(last - first), grain_size, pool,
+            [first, &function](size_type begin, size_type end) -> void {
+                for (size_type index{ begin }; index < end; ++index)
+                    function(first[index]);
+            });
+    }
+
+    /**
+     * Writes <code>function(first[i])</code> to <code>out[i]</code> for every element of
+     * [first, last) in parallel. <code>out</code> must hold at least as many elements.
+     * @param first beginning of the input range
+     * @param last end of the input range
+     * @param out beginning of the output range
+     * @param function callable mapping an input element to an output element
+     * @param grain_size number of elements handled by each task
+     * @param pool pool running the tasks
+     * */
+    template <typename T, typename U, typename Function>
+    auto transform(const T* first, const T* last, U* out, Function function, size_type grain_size = automatic_grain,
+                   thread_pool& pool = thread_pool::default_pool()) -> void
+    {
+        detail::for_chunks(static_cast<size_type>(last - first), grain_size, pool,
+            [first, out, &function](size_type begin, size_type end) -> void {
+                for (size_type index{ begin }; index < end; ++index)
+                    out[index] = function(first[index]);
+            });
+    }
+
+    /**
+     * Combines the elements of [first, last) and <code>init</code> with <code>operation</code>,
+     * which must be associative since partial results are combined in an unspecified grouping.
+     * @param first beginning of the range
+     * @param last end of the range
+     * @param init initial value, also the value returned for an empty range
+     * @param operation associative binary operation
+     * @param grain_size number of elements handled by each task
+     * @param pool pool running the tasks
+     * @returns combination of every element and <code>init</code>
+     * @throws std::bad_alloc if the partial results cannot be allocated
+     * */
+    template <typename T, typename Result, typename Operation = std::plus<>>
+    auto reduce(const T* first, const T* last, Result init, Operation operation = Operation{},
+                size_type grain_size = automatic_grain, thread_pool& pool = thread_pool::default_pool()) -> Result
+    {
+        const size_type count{ static_cast<size_type>(last - first) };
+
+        if (count == 0)
+            return init;
+
+        const size_type grain{ detail::resolve_grain(count, grain_size, pool) };
+        const size_type chunks{ (count + grain - 1) / grain };
+
+        // one slot per chunk, each written by a single task
+        vector<Result> partials(chunks, init);
+
+        if (partials.size() != chunks)
+            throw std::bad_alloc{};
+
+        detail::for_chunks(count, grain, pool,
+            [first, grain, &partials, &operation](size_type begin, size_type end) -> void {
+                Result partial{ static_cast<Result>(first[begin]) };
+
+                for (size_type index{ begin + 1 }; index < end; ++index)
+                    partial = operation(std::move(partial), first[index]);
+
+                partials[begin / grain] = std::move(partial);
+            });
+
+        Result result{ std::move(init) };
+        for (auto& partial : partials)
+            result = operation(std::move(result), std::move(partial));
+
+        return result;
+    }
+
+    /**
+     * Sorts [first, last) in parallel: chunks are sorted independently with <code>std::sort</code>
+     * and merged pairwise, all the merges of a round running at the same time.
+     * @param first beginning of the range
+     * @param last end of the range
+     * @param compare strict weak ordering
+     * @param grain_size minimum number of elements sorted by each task
+     * @param pool pool running the tasks
+     * */
+    template <typename T, typename Compare = std::less<>>
+    auto sort(T* first, T* last, Compare compare = Compare{}, size_type grain_size = automatic_grain,
+              thread_pool& pool = thread_pool::default_pool()) -> void
+    {
+        const size_type count{ static_cast<size_type>(last - first) };
+        const size_type grain{ detail::resolve_grain(count, grain_size, pool) };
+
+        // power of two number of runs so every merge round pairs them up evenly
+        size_type runs{ 1 };
+        while (runs * 2 <= std::min(count / grain, pool.size() * 2))
+            runs *= 2;
+
+        if (runs == 1)
+            return std::sort(first, last, compare);
+
+        const size_type run_size{ (count + runs - 1) / runs };
+        auto run_bound = [first, last, run_size](size_type run) -> T* {
+            return first + std::min(run * run_size, static_cast<size_type>(last - first));
+        };
+
+        detail::for_chunks(runs, 1, pool, [&](size_type begin, size_type end) -> void {
+            for (size_type run{ begin }; run < end; ++run)
+                std::sort(run_bound(run), run_bound(run + 1), compare);
+        });
+
+        for (size_type width{ 1 }; width < runs; width *= 2)
+        {
+            detail::for_chunks(runs / (width * 2), 1, pool, [&](size_type begin, size_type end) -> void {
+                for (size_type pair{ begin }; pair < end; ++pair)
+                {
+                    const size_type run{ pair * width * 2 };
+                    std::inplace_merge(run_bound(run), run_bound(run + width), run_bound(run + width * 2), compare);
+                }
+            });
+        }
+    }
+
+    /**
+     * Assigns <code>value</code> to every element of [first, last) in parallel.
+     * @param first beginning of the range
+     * @param last end of the range
+     * @param value value to be copied
+     * @param grain_size number of elements handled by each task
+     * @param pool pool running the tasks
+     * */
+    template <typename T>
+    auto fill(T* first, T* last, const T& value, size_type grain_size = automatic_grain,
+              thread_pool& pool = thread_pool::default_pool()) -> void
+    {
+        detail::for_chunks(static_cast<size_type>(last - first), grain_size, pool,
+            [first, &value](size_type begin, size_type end) -> void {
+                std::fill(first + begin, first + end, value);
+            });
+    }
+
+    // ---------------------------------------------------------------- vector overloads
+
+    template <typename T, typename Alloc, typename Growth, typename Function>
+    auto for_each(vector<T, Alloc, Growth>& items, Function function, size_type grain_size = automatic_grain,
+                  thread_pool& pool = thread_pool::default_pool()) -> void
+    {
+        for_each(items.data(), items.data() + items.size(), std::move(function), grain_size, pool);
+    }
+
+    /**
+     * Transforms every element of <code>input</code> into the element at the same position of
+     * <code>output</code>, which must hold at least <code>input.size()</code> elements.
+     * */
+    template <typename T, typename AllocIn, typename GrowthIn, typename U, typename AllocOut, typename GrowthOut,
+              typename Function>
+    auto transform(const vector<T, AllocIn, GrowthIn>& input, vector<U, AllocOut, GrowthOut>& output, Function function,
+                   size_type grain_size = automatic_grain, thread_pool& pool = thread_pool::default_pool()) -> void
+    {
+#if !defined(NDEBUG)
+        assert(output.size() >= input.size() && "Output vector is smaller than the input vector");
+#endif
+        transform(input.begin().raw(), input.end().raw(), output.data(), std::move(function), grain_size, pool);
+    }
+
+    template <typename T, typename Alloc, typename Growth, typename Result, typename Operation = std::plus<>>
+    auto reduce(const vector<T, Alloc, Growth>& items, Result init, Operation operation = Operation{},
+                size_type grain_size = automatic_grain, thread_pool& pool = thread_pool::default_pool()) -> Result
+    {
+        return reduce(items.begin().raw(), items.end().raw(), std::move(init), std::move(operation), grain_size, pool);
+    }
+
+    template <typename T, typename Alloc, typename Growth, typename Compare = std::less<>>
+    auto sort(vector<T, Alloc, Growth>& items, Compare compare = Compare{}, size_type grain_size = automatic_grain,
+              thread_pool& pool = thread_pool::default_pool()) -> void
+    {
+        sort(items.data(), items.data() + items.size(), std::move(compare), grain_size, pool);
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    auto fill(vector<T, Alloc, Growth>& items, const T& value, size_type grain_size = automatic_grain,
+              thread_pool& pool = thread_pool::default_pool()) -> void
+    {
+        fill(items.data(), items.data() + items.size(), value, grain_size, pool);
+    }
+
+} // namespace parallel
+
+NAMESPACE_KT_END
+
+#endif // PARALLEL_HH
@@ -0,0 +1,163 @@
+#ifndef RELOCATE_HH
+#define RELOCATE_HH
+
+#include "common.hh"
+
+NAMESPACE_KT_BEG
+
+/**
+ * Tells whether objects of type <code>T</code> can be moved to a different address by
+ * copying their bytes and forgetting the originals (no move constructor plus destructor
+ * pair needed). Every trivially copyable type qualifies. Types that own resources but do
+ * not depend on their own address (e.g. most smart pointers or handle classes) can opt in
+ * by specializing this trait:
+ * <pre>
+ * template <> struct kt::is_trivially_relocatable<my_handle> : std::true_type {};
+ * </pre>
+ * @tparam T type being queried
+ * */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+namespace detail {
+
+    /**
+     * Detects allocators exposing <code>reallocate(pointer, old_count, new_count)</code>,
+     * which is allowed to resize a block in place and preserves its bytes.
+     * */
+    template <typename Alloc, typename = void>
+    struct has_reallocate : std::false_type {};
+
+    template <typename Alloc>
+    struct has_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(
+        std::declval<typename std::allocator_traits<Alloc>::pointer>(),
+        std::declval<typename std::allocator_traits<Alloc>::size_type>(),
+        std::declval<typename std::allocator_traits<Alloc>::size_type>()))>> : std::true_type {};
+
+    template <typename Alloc>
+    inline constexpr bool has_reallocate_v = has_reallocate<Alloc>::value;
+
+    /**
+     * Relocation strategies, from cheapest to most expensive:
+     * <ul>
+     * <li><code>realloc</code>: the allocator may resize the block in place (trivially copyable types only)</li>
+     * <li><code>memcpy</code>: elements are trivially relocatable, their bytes are copied to the new block</li>
+     * <li><code>move</code>: each element is move constructed (or copied if its move may throw) and destroyed</li>
+     * </ul>
+     * */
+    enum class relocation { realloc, memcpy, move };
+
+    template <typename T, typename Alloc>
+    inline constexpr relocation relocation_for{
+        (std::is_trivially_copyable_v<T> && has_reallocate_v<Alloc>) ? relocation::realloc :
+        is_trivially_relocatable_v<T> ? relocation::memcpy : relocation::move
+    };
+
+    /**
+     * Moves <code>count</code> trivially relocatable objects from <code>source</code> to
+     * <code>destination</code> with <code>memmove()</code>, so the ranges may overlap but must lie in
+     * the same block. During constant evaluation, where objects cannot be copied as bytes, each one
+     * is move constructed at its destination and destroyed at its source instead.
+     * */
+    template <typename T>
+    KT_CONSTEXPR auto move_bytes(T* destination, T* source, std::size_t count) noexcept -> void
+    {
+#if KT_CONSTEXPR_VECTOR
+        if (std::is_constant_evaluated())
+        {
+            // walk away from the overlap so that no live object is overwritten
+            if (destination < source)
+            {
+                for (std::size_t index{}; index < count; ++index)
+                {
+                    std::construct_at(destination + index, std::move(source[index]));
+                    std::destroy_at(source + index);
+                }
+            }
+            else
+            {
+                for (std::size_t index{ count }; index-- > 0;)
+                {
+                    std::construct_at(destination + index, std::move(source[index]));
+                    std::destroy_at(source + index);
+                }
+            }
+
+            return;
+        }
+#endif
+        if (count != 0)
+            std::memmove(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+    }
+
+    /**
+     * Copies <code>count</code> trivially copyable objects from <code>source</code> into the
+     * non overlapping <code>destination</code> with <code>memcpy()</code>, or by copy construction
+     * during constant evaluation.
+     * */
+    template <typename T>
+    KT_CONSTEXPR auto copy_bytes(T* destination, const T* source, std::size_t count) noexcept -> void
+    {
+#if KT_CONSTEXPR_VECTOR
+        if (std::is_constant_evaluated())
+        {
+            for (std::size_t index{}; index < count; ++index)
+                std::construct_at(destination + index, source[index]);
+
+            return;
+        }
+#endif
+        if (count != 0)
+            std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+    }
+
+    /**
+     * Moves <code>count</code> elements from <code>source</code> into the uninitialized block
+     * <code>destination</code>, leaving <code>source</code> as raw storage. If an element copy
+     * throws, the already built elements in <code>destination</code> are destroyed and the
+     * source range is left untouched.
+     * */
+    template <typename Alloc, typename T>
+    KT_CONSTEXPR auto relocate(Alloc& alloc, T* source, std::size_t count, T* destination) -> void
+    {
+        using alloc_traits = std::allocator_traits<Alloc>;
+
+        if (count == 0)
+            return;
+
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            // bytes cannot be copied during constant evaluation, the loop below runs instead
+            if (!is_constant_evaluated())
+            {
+                std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+                return;
+            }
+        }
+
+        std::size_t built{};
+
+        try
+        {
+            for (; built < count; ++built)
+                alloc_traits::construct(alloc, destination + built, std::move_if_noexcept(source[built]));
+        }
+        catch (...)
+        {
+            for (std::size_t index{}; index < built; ++index)
+                alloc_traits::destroy(alloc, destination + index);
+            throw;
+        }
+
+        for (std::size_t index{}; index < count; ++index)
+            alloc_traits::destroy(alloc, source + index);
+    }
+
+} // namespace detail
+
+NAMESPACE_KT_END
+
+#endif // RELOCATE_HH
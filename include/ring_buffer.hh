@@ -0,0 +1,678 @@
+#ifndef RING_BUFFER_HH
+#define RING_BUFFER_HH
+
+#include "common.hh"
+#include "allocator.hh"
+#include "relocate.hh"
+#include "span.hh"
+
+NAMESPACE_KT_BEG
+
+namespace detail {
+
+    /**
+     * Growable circular buffer shared by <code>ring_buffer</code> and <code>deque</code>. The capacity
+     * is always a power of two so that logical indices wrap with a mask instead of a division.
+     * Storage comes from <code>Alloc</code> and elements are moved to a bigger block with
+     * <code>detail::relocate</code>, the same way <code>kt::vector</code> grows; afterwards they
+     * are contiguous again, starting at the beginning of the block.
+     * @tparam T type of the elements
+     * @tparam Alloc allocator providing the storage
+     * */
+    template <typename T, typename Alloc>
+    class ring_base
+    {
+        static_assert(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>,
+            "the two halves of the ring are relocated one after another and cannot be rolled back, their moves must not throw");
+
+        using alloc_traits          = std::allocator_traits<Alloc>;
+
+    public:
+        using value_type            = T;
+        using allocator_type        = Alloc;
+        using size_type             = std::size_t;
+        using reference_type        = T&;
+        using pointer_type          = T*;
+        using const_reference_type  = const T&;
+
+        /**
+         * Capacity of the first block, allocated on the first insertion.
+         * */
+        static constexpr size_type first_capacity{ 8 };
+
+        /**
+         * Random access iterator visiting the elements from the front to the back.
+         * */
+        template <bool Const>
+        class basic_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using difference_type   = std::ptrdiff_t;
+            using value_type        = T;
+            using reference         = std::conditional_t<Const, const T&, T&>;
+            using pointer           = std::conditional_t<Const, const T*, T*>;
+            using owner_type        = std::conditional_t<Const, const ring_base, ring_base>;
+
+            basic_iterator() noexcept = default;
+
+            basic_iterator(owner_type* owner, size_type index) noexcept
+                :   m_owner{ owner }, m_index{ index }
+            {}
+
+            // mutable iterators convert to constant ones, not the other way around
+            template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+            basic_iterator(const basic_iterator<OtherConst>& other) noexcept
+                :   m_owner{ other.m_owner }, m_index{ other.m_index }
+            {}
+
+            auto operator*() const -> reference { return (*this->m_owner)[this->m_index]; }
+            auto operator->() const -> pointer { return std::addressof(**this); }
+            auto operator[](difference_type offset) const -> reference { return (*this->m_owner)[this->m_index + offset]; }
+
+            auto operator++() noexcept -> basic_iterator& { ++this->m_index; return *this; }
+            auto operator--() noexcept -> basic_iterator& { --this->m_index; return *this; }
+            auto operator++(int) noexcept -> basic_iterator { return basic_iterator{ this->m_owner, this->m_index++ }; }
+            auto operator--(int) noexcept -> basic_iterator { return basic_iterator{ this->m_owner, this->m_index-- }; }
+
+            auto operator+=(difference_type offset) noexcept -> basic_iterator& { this->m_index += offset; return *this; }
+            auto operator-=(difference_type offset) noexcept -> basic_iterator& { this->m_index -= offset; return *this; }
+            auto operator+(difference_type offset) const noexcept -> basic_iterator { return basic_iterator{ this->m_owner, this->m_index + offset }; }
+            auto operator-(difference_type offset) const noexcept -> basic_iterator { return basic_iterator{ this->m_owner, this->m_index - offset }; }
+
+            friend auto operator+(difference_type offset, const basic_iterator& iterator) noexcept -> basic_iterator
+            {
+                return iterator + offset;
+            }
+
+            friend auto operator-(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> difference_type
+            {
+                return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+            }
+
+            friend auto operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index == rhs.m_index; }
+            friend auto operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index != rhs.m_index; }
+            friend auto operator<(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index < rhs.m_index; }
+            friend auto operator>(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index > rhs.m_index; }
+            friend auto operator<=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index <= rhs.m_index; }
+            friend auto operator>=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index >= rhs.m_index; }
+
+        private:
+            template <bool>
+            friend class basic_iterator;
+
+            owner_type* m_owner{ nullptr };
+            size_type   m_index{ 0 };
+        };
+
+        using iterator_type         = basic_iterator<false>;
+        using const_iterator_type   = basic_iterator<true>;
+
+        /**
+         * Constructs an empty ring, nothing is allocated.
+         * */
+        ring_base() noexcept = default;
+
+        /**
+         * Constructs an empty ring that will obtain its memory from <code>alloc</code>.
+         * @param alloc allocator used for every allocation of this ring
+         * */
+        explicit
+        ring_base(const allocator_type& alloc) noexcept
+            :   m_allocator{ alloc }
+        {}
+
+        /**
+         * Constructs a ring holding copies of the elements of <code>content</code>, in order.
+         * @param content elements to initialize this ring with
+         * @param alloc allocator used for every allocation of this ring
+         * */
+        ring_base(std::initializer_list<value_type> content, const allocator_type& alloc = allocator_type())
+            :   m_allocator{ alloc }
+        {
+            reserve(content.size());
+
+            for (const auto& item : content)
+                push_back(item);
+        }
+
+        /**
+         * Copies the elements of <code>other</code>, which are stored from the beginning of
+         * the new block regardless of where they sit in <code>other</code>.
+         * @param other copied from ring
+         * */
+        ring_base(const ring_base& other)
+            :   m_allocator{ alloc_traits::select_on_container_copy_construction(other.m_allocator) }
+        {
+            try
+            {
+                copy_from(other);
+            }
+            catch (...)
+            {
+                // no destructor runs for a partially constructed object
+                clear();
+                release();
+                throw;
+            }
+        }
+
+        /**
+         * Copy the contents of <code>other</code> into this ring.
+         * @param other copied from ring
+         * @returns <code>*this</code>
+         * */
+        auto operator=(const ring_base& other) -> ring_base&
+        {
+            if (this != &other)
+            {
+                clear();
+
+                if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+                {
+                    // the incoming allocator could not free the current block
+                    if (!alloc_traits::is_always_equal::value && this->m_allocator != other.m_allocator)
+                        release();
+
+                    this->m_allocator = other.m_allocator;
+                }
+
+                copy_from(other);
+            }
+
+            return *this;
+        }
+
+        /**
+         * Takes the storage of <code>other</code>, which is left empty.
+         * @param other moved from ring
+         * */
+        ring_base(ring_base&& other) noexcept
+            :   m_allocator{ std::move(other.m_allocator) }
+        {
+            steal(other);
+        }
+
+        /**
+         * Takes the storage of <code>other</code>, which is left empty. If the allocators do not
+         * propagate and compare unequal the elements are moved one by one instead.
+         * @param other moved from ring
+         * @returns <code>*this</code>
+         * */
+        auto operator=(ring_base&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                                  alloc_traits::is_always_equal::value) -> ring_base&
+        {
+            if (this != &other)
+            {
+                clear();
+
+                if constexpr (alloc_traits::propagate_on_container_move_assignment::value ||
+                              alloc_traits::is_always_equal::value)
+                {
+                    release();
+
+                    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+                        this->m_allocator = std::move(other.m_allocator);
+
+                    steal(other);
+                }
+                else if (this->m_allocator == other.m_allocator)
+                {
+                    release();
+                    steal(other);
+                }
+                else
+                {
+                    // storage cannot change hands, move the elements over instead
+                    reserve(other.m_count);
+
+                    for (size_type index{}; index < other.m_count && this->m_count < this->m_capacity; ++index)
+                        push_back(std::move(other[index]));
+
+                    other.clear();
+                }
+            }
+
+            return *this;
+        }
+
+        /**
+         * Calls the destructor for all the elements and frees the underlying block.
+         * */
+        ~ring_base()
+        {
+            clear();
+            release();
+        }
+
+        [[nodiscard]]
+        auto get_allocator() const noexcept -> allocator_type
+        {
+            return this->m_allocator;
+        }
+
+        [[nodiscard]]
+        auto size() const noexcept -> size_type
+        {
+            return this->m_count;
+        }
+
+        /**
+         * Returns the number of elements this ring has allocated space for, zero or a power of two.
+         * @returns capacity of this ring
+         * */
+        [[nodiscard]]
+        auto capacity() const noexcept -> size_type
+        {
+            return this->m_capacity;
+        }
+
+        [[nodiscard]]
+        auto empty() const noexcept -> bool
+        {
+            return this->m_count == 0;
+        }
+
+        /**
+         * Returns a reference to the element <code>index</code> positions away from the front.
+         * @param index logical index of the element, <code>0</code> is the front
+         * @returns reference to the element at the given index
+         * */
+        [[nodiscard]]
+        auto operator[](size_type index) -> reference_type
+        {
+#if !defined(NDEBUG)
+            assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+            return *slot(index);
+        }
+
+        [[nodiscard]]
+        auto operator[](size_type index) const -> const_reference_type
+        {
+#if !defined(NDEBUG)
+            assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+            return *slot(index);
+        }
+
+        /**
+         * Return reference to element at logical position <code>index</code>.
+         * @param index index of the element to be returned
+         * @returns reference to the element at the given index
+         * @throws std::out_of_range if the index is out of bounds
+         * */
+        auto at(size_type index) -> reference_type
+        {
+            if (index >= size())
+                throw std::out_of_range("Attempting to access an element out of range");
+
+            return (*this)[index];
+        }
+
+        auto at(size_type index) const -> const_reference_type
+        {
+            if (index >= size())
+                throw std::out_of_range("Attempting to access an element out of range");
+
+            return (*this)[index];
+        }
+
+        [[nodiscard]]
+        auto front() noexcept -> reference_type { return (*this)[0]; }
+
+        [[nodiscard]]
+        auto back() noexcept -> reference_type { return (*this)[size() - 1]; }
+
+        [[nodiscard]]
+        auto front() const noexcept -> const_reference_type { return (*this)[0]; }
+
+        [[nodiscard]]
+        auto back() const noexcept -> const_reference_type { return (*this)[size() - 1]; }
+
+        [[nodiscard]]
+        auto begin() noexcept -> iterator_type { return iterator_type{ this, 0 }; }
+
+        [[nodiscard]]
+        auto end() noexcept -> iterator_type { return iterator_type{ this, this->m_count }; }
+
+        [[nodiscard]]
+        auto begin() const noexcept -> const_iterator_type { return const_iterator_type{ this, 0 }; }
+
+        [[nodiscard]]
+        auto end() const noexcept -> const_iterator_type { return const_iterator_type{ this, this->m_count }; }
+
+        [[nodiscard]]
+        auto cbegin() const noexcept -> const_iterator_type { return begin(); }
+
+        [[nodiscard]]
+        auto cend() const noexcept -> const_iterator_type { return end(); }
+
+        /**
+         * Returns the elements as at most two contiguous runs: the first one starts at the front,
+         * the second one, empty unless the elements wrap around the end of the block, ends at the
+         * back. Consumers can process each run in one go, e.g. with a single <code>write()</code>
+         * or a vectorized loop, then drop them with <code>pop_front_n()</code>.
+         * @returns the run starting at the front and the run ending at the back
+         * */
+        [[nodiscard]]
+        auto spans() noexcept -> std::pair<span<value_type>, span<value_type>>
+        {
+            const size_type first{ first_run() };
+            return { span<value_type>{ this->m_array + this->m_head, first },
+                     span<value_type>{ this->m_array, this->m_count - first } };
+        }
+
+        [[nodiscard]]
+        auto spans() const noexcept -> std::pair<span<const value_type>, span<const value_type>>
+        {
+            const size_type first{ first_run() };
+            return { span<const value_type>{ this->m_array + this->m_head, first },
+                     span<const value_type>{ this->m_array, this->m_count - first } };
+        }
+
+        /**
+         * Makes room for at least <code>new_count</code> elements, rounded up to a power of two.
+         * @param new_count number of elements this ring must be able to hold
+         * */
+        auto reserve(size_type new_count) -> void
+        {
+            if (new_count > this->m_capacity)
+                reallocate_to(round_capacity(new_count));
+        }
+
+        /**
+         * Construct element in place at the back of this ring, doubling the capacity if it is full.
+         * @param args arguments to construct the new object
+         * @tparam Args types of the parameters of this function
+         * */
+        template <typename... Args>
+        auto emplace_back(Args&&... args) -> void
+        {
+            if (this->m_count == this->m_capacity)
+                return grow_and_emplace(this->m_count, std::forward<Args>(args)...);
+
+            alloc_traits::construct(this->m_allocator, slot(this->m_count), std::forward<Args>(args)...);
+            ++(this->m_count);
+        }
+
+        auto push_back(const_reference_type elem) -> void
+        {
+            emplace_back(elem);
+        }
+
+        auto push_back(value_type&& elem) -> void
+        {
+            emplace_back(std::move(elem));
+        }
+
+        /**
+         * Construct element in place at the front of this ring, doubling the capacity if it is full.
+         * @param args arguments to construct the new object
+         * @tparam Args types of the parameters of this function
+         * */
+        template <typename... Args>
+        auto emplace_front(Args&&... args) -> void
+        {
+            if (this->m_count == this->m_capacity)
+                return grow_and_emplace(0, std::forward<Args>(args)...);
+
+            const size_type head{ (this->m_head - 1) & (this->m_capacity - 1) };
+
+            alloc_traits::construct(this->m_allocator, this->m_array + head, std::forward<Args>(args)...);
+            this->m_head = head;
+            ++(this->m_count);
+        }
+
+        auto push_front(const_reference_type elem) -> void
+        {
+            emplace_front(elem);
+        }
+
+        auto push_front(value_type&& elem) -> void
+        {
+            emplace_front(std::move(elem));
+        }
+
+        /**
+         * Remove the front element. If this ring is empty this operation has no effect.
+         * */
+        auto pop_front() -> void
+        {
+            pop_front_n(1);
+        }
+
+        /**
+         * Destroy the first <code>count</code> elements, or every element if there are less.
+         * @param count number of elements to be removed from the front
+         * */
+        auto pop_front_n(size_type count) -> void
+        {
+            count = std::min(count, this->m_count);
+
+            for (size_type index{}; index < count; ++index)
+                alloc_traits::destroy(this->m_allocator, slot(index));
+
+            this->m_count -= count;
+
+            // an empty ring starts over at the beginning of the block, keeping the next run whole
+            this->m_head = this->m_count == 0 ? 0 : (this->m_head + count) & (this->m_capacity - 1);
+        }
+
+        /**
+         * Remove the back element. If this ring is empty this operation has no effect.
+         * */
+        auto pop_back() -> void
+        {
+            pop_back_n(1);
+        }
+
+        /**
+         * Destroy the last <code>count</code> elements, or every element if there are less.
+         * @param count number of elements to be removed from the back
+         * */
+        auto pop_back_n(size_type count) -> void
+        {
+            count = std::min(count, this->m_count);
+
+            for (size_type index{ this->m_count - count }; index < this->m_count; ++index)
+                alloc_traits::destroy(this->m_allocator, slot(index));
+
+            this->m_count -= count;
+
+            if (this->m_count == 0)
+                this->m_head = 0;
+        }
+
+        /**
+         * Remove all the elements. The block is kept.
+         * */
+        auto clear() -> void
+        {
+            pop_front_n(this->m_count);
+        }
+
+    private:
+        auto slot(size_type index) const noexcept -> pointer_type
+        {
+            return this->m_array + ((this->m_head + index) & (this->m_capacity - 1));
+        }
+
+        /**
+         * Returns the number of elements between the front and the end of the block.
+         * */
+        auto first_run() const noexcept -> size_type
+        {
+            return std::min(this->m_count, this->m_capacity - this->m_head);
+        }
+
+        static auto round_capacity(size_type count) noexcept -> size_type
+        {
+            size_type capacity{ first_capacity };
+
+            while (capacity < count)
+                capacity *= 2;
+
+            return capacity;
+        }
+
+        /**
+         * Doubles the capacity of this full ring and adds an element either at the front
+         * (<code>position</code> 0) or at the back (<code>position</code> <code>size()</code>).
+         * The element is built first since <code>args</code> may refer to an element of this ring.
+         * */
+        template <typename... Args>
+        auto grow_and_emplace(size_type position, Args&&... args) -> void
+        {
+            value_type value(std::forward<Args>(args)...);
+
+            if (!reallocate_to(this->m_capacity == 0 ? first_capacity : this->m_capacity * 2))
+                return;
+
+            // after growing the elements start at the beginning of a block with free room past them
+            if (position == 0)
+                this->m_head = this->m_capacity - 1;
+
+            alloc_traits::construct(this->m_allocator, position == 0 ? this->m_array + this->m_head : slot(this->m_count),
+                                    std::move(value));
+            ++(this->m_count);
+        }
+
+        /**
+         * Relocates the elements to a new block of <code>new_capacity</code> elements, unwrapping
+         * them so that the front lands at the beginning of the block. On failure this ring is
+         * left untouched.
+         * @param new_capacity capacity of the new block, a power of two not smaller than <code>size()</code>
+         * @returns <code>true</code> if this ring now has the requested capacity
+         * */
+        auto reallocate_to(size_type new_capacity) -> bool
+        {
+            pointer_type new_block{ alloc_traits::allocate(this->m_allocator, new_capacity) };
+
+            if (new_block == nullptr)
+            {
+#if !defined(NDEBUG)
+                std::printf("Failed to allocate new block of memory");
+#endif
+                return false;
+            }
+
+            // moves cannot throw (see the static_assert above), no rollback is needed in between
+            const size_type first{ first_run() };
+            relocate(this->m_allocator, this->m_array + this->m_head, first, new_block);
+            relocate(this->m_allocator, this->m_array, this->m_count - first, new_block + first);
+
+            release();
+
+            this->m_array = new_block;
+            this->m_capacity = new_capacity;
+            this->m_head = 0;
+
+            return true;
+        }
+
+        auto release() noexcept -> void
+        {
+            if (this->m_array != nullptr)
+                alloc_traits::deallocate(this->m_allocator, this->m_array, this->m_capacity);
+
+            this->m_array = nullptr;
+            this->m_capacity = 0;
+            this->m_head = 0;
+        }
+
+        /**
+         * Appends copies of the elements of <code>other</code> to this empty ring. If a copy throws
+         * the elements copied so far are kept.
+         * */
+        auto copy_from(const ring_base& other) -> void
+        {
+            reserve(other.m_count);
+
+            if (this->m_capacity < other.m_count)
+                return;
+
+            for (size_type index{}; index < other.m_count; ++index)
+                push_back(other[index]);
+        }
+
+        auto steal(ring_base& other) noexcept -> void
+        {
+            this->m_array = std::exchange(other.m_array, nullptr);
+            this->m_head = std::exchange(other.m_head, 0);
+            this->m_count = std::exchange(other.m_count, 0);
+            this->m_capacity = std::exchange(other.m_capacity, 0);
+        }
+
+        pointer_type    m_array{ nullptr };
+        size_type       m_head{ 0 };
+        size_type       m_count{ 0 };
+        size_type       m_capacity{ 0 };
+        allocator_type  m_allocator{};
+
+        /**
+         * <h3>CONSTRAINTS: m_capacity >= m_count >= 0, m_capacity is 0 or a power of two, m_head < max(m_capacity, 1)</h3>
+         *
+         * <p>the element with logical index <code>i</code> lives at <code>m_array[(m_head + i) & (m_capacity - 1)]</code></br></p>
+         * */
+    };
+
+} // namespace detail
+
+/**
+ * First in, first out queue over a growable circular buffer: elements are appended at the back
+ * and consumed from the front, in O(1) and without shifting the rest. While the producer keeps
+ * up with the consumer no allocation happens; when the buffer is full its capacity doubles.
+ * Consumers can drain whole runs at once through <code>spans()</code> and <code>pop_front_n()</code>.
+ * @tparam T type of the elements, its moves must not throw unless it is trivially relocatable
+ * @tparam Alloc allocator providing the storage
+ * */
+template <typename T, typename Alloc = allocator<T>>
+class ring_buffer : private detail::ring_base<T, Alloc>
+{
+    using base_type = detail::ring_base<T, Alloc>;
+
+public:
+    using typename base_type::value_type;
+    using typename base_type::allocator_type;
+    using typename base_type::size_type;
+    using typename base_type::reference_type;
+    using typename base_type::pointer_type;
+    using typename base_type::const_reference_type;
+    using typename base_type::iterator_type;
+    using typename base_type::const_iterator_type;
+
+    using base_type::base_type;
+    using base_type::first_capacity;
+
+    using base_type::get_allocator;
+    using base_type::size;
+    using base_type::capacity;
+    using base_type::empty;
+    using base_type::operator[];
+    using base_type::at;
+    using base_type::front;
+    using base_type::back;
+    using base_type::begin;
+    using base_type::end;
+    using base_type::cbegin;
+    using base_type::cend;
+    using base_type::spans;
+    using base_type::reserve;
+    using base_type::emplace_back;
+    using base_type::push_back;
+    using base_type::pop_front;
+    using base_type::pop_front_n;
+    using base_type::clear;
+
+protected:
+    // double ended access, made public by kt::deque
+    using base_type::emplace_front;
+    using base_type::push_front;
+    using base_type::pop_back;
+    using base_type::pop_back_n;
+};
+
+NAMESPACE_KT_END
+
+#endif // RING_BUFFER_HH
@@ -0,0 +1,257 @@
+#ifndef SERIALIZE_HH
+#define SERIALIZE_HH
+
+#include <cerrno>
+#include <cstdio>
+#include <limits>
+
+#include "common.hh"
+#include "vector.hh"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+    #error "kt::serialize requires a POSIX system"
+#endif
+
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+
+NAMESPACE_KT_BEG
+
+/**
+ * Outcome of <code>serialize()</code> and <code>deserialize()</code>.
+ * */
+enum class serialization_status
+{
+    ok,
+    io_error,           // read/write failed or the stream ended early, see errno
+    bad_magic,          // the data does not start with a serialized vector
+    version_mismatch,   // written by an incompatible version of the format
+    layout_mismatch,    // element size or alignment differ from the ones of the receiving vector
+    byte_order_mismatch,// written on a machine with the opposite endianness
+    corrupt,            // the element count cannot be right: too big for memory or for the file
+    out_of_memory       // the buffer for the elements could not be allocated
+};
+
+/**
+ * Header preceding the elements of a serialized vector. Every field is stored in the byte
+ * order of the writing machine; <code>byte_order</code> lets readers detect a mismatch.
+ * */
+struct serialization_header
+{
+    static constexpr char           MAGIC[8]{ 'K', 'T', 'V', 'E', 'C', 'T', 'O', 'R' };
+    static constexpr std::uint32_t  VERSION{ 1 };
+    static constexpr std::uint32_t  BYTE_ORDER_MARK{ 0x01020304 };
+
+    char            magic[8];
+    std::uint32_t   version;
+    std::uint32_t   byte_order;
+    std::uint32_t   element_size;
+    std::uint32_t   element_alignment;
+    std::uint64_t   count;
+};
+
+static_assert(sizeof(serialization_header) == 32 && std::is_trivially_copyable_v<serialization_header>);
+
+namespace detail {
+
+    /**
+     * Writes every byte described by <code>parts</code>, resuming after short writes.
+     * */
+    inline auto write_all(int descriptor, ::iovec* parts, int part_count) noexcept -> bool
+    {
+        while (part_count > 0)
+        {
+            const ::ssize_t written{ ::writev(descriptor, parts, part_count) };
+
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                return false;
+            }
+
+            // drop the parts written completely, advance into the first one written partially
+            auto remaining{ static_cast<std::size_t>(written) };
+            while (part_count > 0 && remaining >= parts->iov_len)
+            {
+                remaining -= parts->iov_len;
+                ++parts;
+                --part_count;
+            }
+
+            if (part_count > 0)
+            {
+                parts->iov_base = static_cast<char*>(parts->iov_base) + remaining;
+                parts->iov_len -= remaining;
+            }
+        }
+
+        return true;
+    }
+
+    inline auto read_all(int descriptor, void* destination, std::size_t bytes) noexcept -> bool
+    {
+        auto* cursor{ static_cast<char*>(destination) };
+
+        while (bytes > 0)
+        {
+            const ::ssize_t got{ ::read(descriptor, cursor, bytes) };
+
+            if (got < 0 && errno == EINTR)
+                continue;
+
+            if (got <= 0)
+                return false;
+
+            cursor += got;
+            bytes -= static_cast<std::size_t>(got);
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    auto make_header(std::size_t count) noexcept -> serialization_header
+    {
+        serialization_header header{};
+
+        std::memcpy(header.magic, serialization_header::MAGIC, sizeof(header.magic));
+        header.version = serialization_header::VERSION;
+        header.byte_order = serialization_header::BYTE_ORDER_MARK;
+        header.element_size = static_cast<std::uint32_t>(sizeof(T));
+        header.element_alignment = static_cast<std::uint32_t>(alignof(T));
+        header.count = count;
+
+        return header;
+    }
+
+    template <typename T>
+    auto check_header(const serialization_header& header) noexcept -> serialization_status
+    {
+        if (std::memcmp(header.magic, serialization_header::MAGIC, sizeof(header.magic)) != 0)
+            return serialization_status::bad_magic;
+
+        if (header.byte_order != serialization_header::BYTE_ORDER_MARK)
+            return serialization_status::byte_order_mismatch;
+
+        if (header.version != serialization_header::VERSION)
+            return serialization_status::version_mismatch;
+
+        if (header.element_size != sizeof(T) || header.element_alignment != alignof(T))
+            return serialization_status::layout_mismatch;
+
+        return serialization_status::ok;
+    }
+
+    /**
+     * Returns <code>false</code> if <code>descriptor</code> is a regular file holding fewer than
+     * <code>bytes</code> bytes past its current offset. Pipes and sockets cannot tell and pass.
+     * */
+    inline auto payload_fits(int descriptor, std::uint64_t bytes) noexcept -> bool
+    {
+        struct ::stat status{};
+
+        if (::fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode))
+            return true;
+
+        const ::off_t offset{ ::lseek(descriptor, 0, SEEK_CUR) };
+
+        if (offset < 0 || offset > status.st_size)
+            return true;
+
+        return bytes <= static_cast<std::uint64_t>(status.st_size - offset);
+    }
+
+} // namespace detail
+
+/**
+ * Writes <code>items</code> to <code>descriptor</code> (a file, pipe or socket) as a header followed
+ * by the raw bytes of the elements, with a single <code>writev()</code> call unless the kernel
+ * accepts fewer bytes at once.
+ * @param descriptor open file descriptor the vector is written to
+ * @param items vector to be written, its elements must be trivially copyable
+ * @returns <code>serialization_status::ok</code> or <code>serialization_status::io_error</code>
+ * */
+template <typename T, typename Alloc, typename Growth>
+auto serialize(int descriptor, const vector<T, Alloc, Growth>& items) noexcept -> serialization_status
+{
+    static_assert(std::is_trivially_copyable_v<T>, "only vectors of trivially copyable elements can be serialized");
+
+    serialization_header header{ detail::make_header<T>(items.size()) };
+
+    ::iovec parts[2]{
+        { static_cast<void*>(&header), sizeof(header) },
+        { const_cast<void*>(static_cast<const void*>(items.begin().raw())), items.size() * sizeof(T) }
+    };
+
+    return detail::write_all(descriptor, parts, items.empty() ? 1 : 2) ?
+        serialization_status::ok : serialization_status::io_error;
+}
+
+/**
+ * Reads a vector written by <code>serialize()</code> from <code>descriptor</code> into <code>items</code>.
+ * The elements are read straight into a block from the allocator of <code>items</code>, which then
+ * adopts it: no element is constructed nor copied one by one. On failure <code>items</code> is left
+ * untouched; the descriptor may have been partially consumed. A count that cannot fit in memory, or
+ * in the rest of the file when reading a regular file, is reported as corrupt before allocating.
+ * @param descriptor open file descriptor the vector is read from
+ * @param items vector receiving the elements, its previous contents are discarded
+ * @returns <code>serialization_status::ok</code> or the reason why the vector could not be read
+ * */
+template <typename T, typename Alloc, typename Growth>
+auto deserialize(int descriptor, vector<T, Alloc, Growth>& items) -> serialization_status
+{
+    static_assert(std::is_trivially_copyable_v<T>, "only vectors of trivially copyable elements can be deserialized");
+
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+    serialization_header header{};
+
+    if (!detail::read_all(descriptor, &header, sizeof(header)))
+        return serialization_status::io_error;
+
+    if (const auto status{ detail::check_header<T>(header) }; status != serialization_status::ok)
+        return status;
+
+    Alloc alloc{ items.get_allocator() };
+
+    // the count comes from outside: the size of the payload in bytes must not wrap around
+    if (header.count > std::min<std::uint64_t>(alloc_traits::max_size(alloc), std::numeric_limits<std::size_t>::max() / sizeof(T)))
+        return serialization_status::corrupt;
+
+    const auto count{ static_cast<std::size_t>(header.count) };
+
+    if (!detail::payload_fits(descriptor, std::uint64_t{ count } * sizeof(T)))
+        return serialization_status::corrupt;
+
+    if (count == 0)
+    {
+        items.adopt(nullptr, 0, 0);
+        return serialization_status::ok;
+    }
+
+    T* block{ alloc_traits::allocate(alloc, count) };
+
+    if (block == nullptr)
+    {
+#if !defined(NDEBUG)
+        std::printf("could not allocate block of memory...");
+#endif
+        return serialization_status::out_of_memory;
+    }
+
+    if (!detail::read_all(descriptor, static_cast<void*>(block), count * sizeof(T)))
+    {
+        alloc_traits::deallocate(alloc, block, count);
+        return serialization_status::io_error;
+    }
+
+    items.adopt(block, count, count);
+    return serialization_status::ok;
+}
+
+NAMESPACE_KT_END
+
+#endif // SERIALIZE_HH
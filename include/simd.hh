@@ -0,0 +1,441 @@
+#ifndef SIMD_HH
+#define SIMD_HH
+
+#include "common.hh"
+#include "vector.hh"
+
+// Vectorized kernels are built with GCC vector extensions under per-region target options,
+// so a single binary carries SSE2, AVX2 and AVX-512 versions and picks one at runtime.
+// Other compilers and architectures fall back to the scalar loops.
+#if !defined(KT_SIMD_X86)
+    #if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+        #define KT_SIMD_X86 1
+    #else
+        #define KT_SIMD_X86 0
+    #endif
+#endif
+
+NAMESPACE_KT_BEG
+
+/**
+ * Search and reduction kernels over contiguous ranges of arithmetic elements.
+ * Ranges are given as pointers, <code>kt::vector</code> iterators or whole vectors.
+ *
+ * <p>Floating point sums and dot products are accumulated in several partial sums,
+ * so their rounding differs from a sequential loop. Minimum and maximum are unspecified
+ * if the range contains NaNs.</p>
+ * */
+namespace simd {
+
+    /**
+     * Instruction set extensions the kernels can be dispatched to, ordered by width.
+     * */
+    enum class isa { scalar, sse2, avx2, avx512 };
+
+    /**
+     * Returns the widest instruction set supported by the running processor.
+     * Detection runs once, later calls return the cached result.
+     * @returns instruction set used by the kernels
+     * */
+    inline auto detected_isa() noexcept -> isa
+    {
+#if KT_SIMD_X86
+        static const isa level{ []() -> isa {
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+                __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+                return isa::avx512;
+            if (__builtin_cpu_supports("avx2"))
+                return isa::avx2;
+            if (__builtin_cpu_supports("sse2"))
+                return isa::sse2;
+
+            return isa::scalar;
+        }() };
+
+        return level;
+#else
+        return isa::scalar;
+#endif
+    }
+
+    namespace detail {
+
+        /**
+         * Element types with a vectorized implementation. Narrow integers are left out, their
+         * sums and products would overflow long before a reduction is worth vectorizing.
+         * */
+        template <typename T>
+        inline constexpr bool vectorizable_v{ std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                                              (sizeof(T) == 4 || sizeof(T) == 8) };
+
+        // ---------------------------------------------------------------- scalar kernels
+
+        template <typename T>
+        auto find_scalar(const T* first, std::size_t count, T value) noexcept -> const T*
+        {
+            for (std::size_t index{}; index < count; ++index)
+                if (first[index] == value)
+                    return first + index;
+
+            return first + count;
+        }
+
+        template <typename T>
+        auto count_scalar(const T* first, std::size_t count, T value) noexcept -> std::size_t
+        {
+            std::size_t matches{};
+
+            for (std::size_t index{}; index < count; ++index)
+                matches += first[index] == value;
+
+            return matches;
+        }
+
+        template <typename T>
+        auto min_scalar(const T* first, std::size_t count) noexcept -> T
+        {
+            T result{ first[0] };
+
+            for (std::size_t index{ 1 }; index < count; ++index)
+                result = first[index] < result ? first[index] : result;
+
+            return result;
+        }
+
+        template <typename T>
+        auto max_scalar(const T* first, std::size_t count) noexcept -> T
+        {
+            T result{ first[0] };
+
+            for (std::size_t index{ 1 }; index < count; ++index)
+                result = result < first[index] ? first[index] : result;
+
+            return result;
+        }
+
+        template <typename T>
+        auto sum_scalar(const T* first, std::size_t count) noexcept -> T
+        {
+            T result{};
+
+            for (std::size_t index{}; index < count; ++index)
+                result += first[index];
+
+            return result;
+        }
+
+        template <typename T>
+        auto dot_scalar(const T* lhs, const T* rhs, std::size_t count) noexcept -> T
+        {
+            T result{};
+
+            for (std::size_t index{}; index < count; ++index)
+                result += lhs[index] * rhs[index];
+
+            return result;
+        }
+
+#if KT_SIMD_X86
+        // One copy of the vector kernels per instruction set, each compiled with its own
+        // target options so the vector types get the register width they ask for.
+    #pragma GCC push_options
+    #pragma GCC target("sse2")
+    #define KT_SIMD_ISA sse2
+    #define KT_SIMD_BYTES 16
+    #include "simd_kernels.hh"
+    #undef KT_SIMD_BYTES
+    #undef KT_SIMD_ISA
+    #pragma GCC pop_options
+
+    #pragma GCC push_options
+    #pragma GCC target("avx2")
+    #define KT_SIMD_ISA avx2
+    #define KT_SIMD_BYTES 32
+    #include "simd_kernels.hh"
+    #undef KT_SIMD_BYTES
+    #undef KT_SIMD_ISA
+    #pragma GCC pop_options
+
+    // mask to vector conversions need DQ/BW, every AVX-512 server core since Skylake has them
+    #pragma GCC push_options
+    #pragma GCC target("avx512f,avx512dq,avx512bw,avx512vl")
+    #define KT_SIMD_ISA avx512
+    #define KT_SIMD_BYTES 64
+    #include "simd_kernels.hh"
+    #undef KT_SIMD_BYTES
+    #undef KT_SIMD_ISA
+    #pragma GCC pop_options
+
+#define KT_SIMD_DISPATCH(name, ...)                                                                             \
+        if constexpr (vectorizable_v<T>)                                                                        \
+        {                                                                                                       \
+            switch (detected_isa())                                                                             \
+            {                                                                                                   \
+                case isa::avx512:   return avx512::name(__VA_ARGS__);                                           \
+                case isa::avx2:     return avx2::name(__VA_ARGS__);                                             \
+                case isa::sse2:     return sse2::name(__VA_ARGS__);                                             \
+                case isa::scalar:   break;                                                                      \
+            }                                                                                                   \
+        }                                                                                                       \
+        return name##_scalar(__VA_ARGS__);
+#else
+#define KT_SIMD_DISPATCH(name, ...) return name##_scalar(__VA_ARGS__);
+#endif
+
+        template <typename T>
+        auto find(const T* first, std::size_t count, T value) noexcept -> const T*
+        {
+            KT_SIMD_DISPATCH(find, first, count, value)
+        }
+
+        template <typename T>
+        auto count(const T* first, std::size_t count, T value) noexcept -> std::size_t
+        {
+            KT_SIMD_DISPATCH(count, first, count, value)
+        }
+
+        template <typename T>
+        auto min(const T* first, std::size_t count) noexcept -> T
+        {
+            KT_SIMD_DISPATCH(min, first, count)
+        }
+
+        template <typename T>
+        auto max(const T* first, std::size_t count) noexcept -> T
+        {
+            KT_SIMD_DISPATCH(max, first, count)
+        }
+
+        template <typename T>
+        auto sum(const T* first, std::size_t count) noexcept -> T
+        {
+            KT_SIMD_DISPATCH(sum, first, count)
+        }
+
+        template <typename T>
+        auto dot(const T* lhs, const T* rhs, std::size_t count) noexcept -> T
+        {
+            KT_SIMD_DISPATCH(dot, lhs, rhs, count)
+        }
+
+#undef KT_SIMD_DISPATCH
+
+        template <typename T>
+        auto range_size(const T* first, const T* last) noexcept -> std::size_t
+        {
+            return static_cast<std::size_t>(last - first);
+        }
+
+    } // namespace detail
+
+    /**
+     * Returns a pointer to the first element equal to <code>value</code> in [first, last),
+     * or <code>last</code> if there is none.
+     * @param first beginning of the range
+     * @param last end of the range
+     * @param value value to search for
+     * @returns pointer to the first match or <code>last</code>
+     * */
+    template <typename T>
+    auto find(const T* first, const T* last, T value) noexcept -> const T*
+    {
+        return detail::find(first, detail::range_size(first, last), value);
+    }
+
+    /**
+     * Returns the number of elements equal to <code>value</code> in [first, last).
+     * @param first beginning of the range
+     * @param last end of the range
+     * @param value value to count
+     * @returns number of matches
+     * */
+    template <typename T>
+    auto count(const T* first, const T* last, T value) noexcept -> std::size_t
+    {
+        return detail::count(first, detail::range_size(first, last), value);
+    }
+
+    /**
+     * Returns the smallest element of the non empty range [first, last).
+     * @param first beginning of the range
+     * @param last end of the range
+     * @returns smallest element
+     * */
+    template <typename T>
+    auto min(const T* first, const T* last) noexcept -> T
+    {
+#if !defined(NDEBUG)
+        assert(first != last && "Attempting to compute the minimum of an empty range");
+#endif
+        return detail::min(first, detail::range_size(first, last));
+    }
+
+    /**
+     * Returns the largest element of the non empty range [first, last).
+     * @param first beginning of the range
+     * @param last end of the range
+     * @returns largest element
+     * */
+    template <typename T>
+    auto max(const T* first, const T* last) noexcept -> T
+    {
+#if !defined(NDEBUG)
+        assert(first != last && "Attempting to compute the maximum of an empty range");
+#endif
+        return detail::max(first, detail::range_size(first, last));
+    }
+
+    /**
+     * Returns the sum of the elements in [first, last), zero for an empty range.
+     * @param first beginning of the range
+     * @param last end of the range
+     * @returns sum of the elements
+     * */
+    template <typename T>
+    auto sum(const T* first, const T* last) noexcept -> T
+    {
+        return detail::sum(first, detail::range_size(first, last));
+    }
+
+    /**
+     * Returns the dot product of [first, last) and the range of the same
+     * length starting at <code>other</code>.
+     * @param first beginning of the first range
+     * @param last end of the first range
+     * @param other beginning of the second range
+     * @returns sum of the pairwise products
+     * */
+    template <typename T>
+    auto dot(const T* first, const T* last, const T* other) noexcept -> T
+    {
+        return detail::dot(first, other, detail::range_size(first, last));
+    }
+
+    // ---------------------------------------------------------------- iterator overloads
+
+    template <typename T>
+    auto find(const_iterator<T> first, const_iterator<T> last, T value) noexcept -> const_iterator<T>
+    {
+        return const_iterator<T>{ const_cast<T*>(find<T>(first.raw(), last.raw(), value)) };
+    }
+
+    template <typename T>
+    auto find(iterator<T> first, iterator<T> last, T value) noexcept -> iterator<T>
+    {
+        return iterator<T>{ const_cast<T*>(find<T>(first.raw(), last.raw(), value)) };
+    }
+
+    template <typename T>
+    auto count(const_iterator<T> first, const_iterator<T> last, T value) noexcept -> std::size_t
+    {
+        return count<T>(first.raw(), last.raw(), value);
+    }
+
+    template <typename T>
+    auto min(const_iterator<T> first, const_iterator<T> last) noexcept -> T
+    {
+        return min<T>(first.raw(), last.raw());
+    }
+
+    template <typename T>
+    auto max(const_iterator<T> first, const_iterator<T> last) noexcept -> T
+    {
+        return max<T>(first.raw(), last.raw());
+    }
+
+    template <typename T>
+    auto sum(const_iterator<T> first, const_iterator<T> last) noexcept -> T
+    {
+        return sum<T>(first.raw(), last.raw());
+    }
+
+    template <typename T>
+    auto dot(const_iterator<T> first, const_iterator<T> last, const_iterator<T> other) noexcept -> T
+    {
+        return dot<T>(first.raw(), last.raw(), other.raw());
+    }
+
+    template <typename T>
+    auto count(iterator<T> first, iterator<T> last, T value) noexcept -> std::size_t
+    {
+        return count<T>(first.raw(), last.raw(), value);
+    }
+
+    template <typename T>
+    auto min(iterator<T> first, iterator<T> last) noexcept -> T
+    {
+        return min<T>(first.raw(), last.raw());
+    }
+
+    template <typename T>
+    auto max(iterator<T> first, iterator<T> last) noexcept -> T
+    {
+        return max<T>(first.raw(), last.raw());
+    }
+
+    template <typename T>
+    auto sum(iterator<T> first, iterator<T> last) noexcept -> T
+    {
+        return sum<T>(first.raw(), last.raw());
+    }
+
+    template <typename T>
+    auto dot(iterator<T> first, iterator<T> last, iterator<T> other) noexcept -> T
+    {
+        return dot<T>(first.raw(), last.raw(), other.raw());
+    }
+
+    // ---------------------------------------------------------------- vector overloads
+
+    /**
+     * Returns the index of the first element equal to <code>value</code> in
+     * <code>items</code>, or <code>items.size()</code> if there is none.
+     * */
+    template <typename T, typename Alloc, typename Growth>
+    auto find(const vector<T, Alloc, Growth>& items, T value) noexcept -> std::size_t
+    {
+        const T* first{ items.begin().raw() };
+        return detail::range_size(first, detail::find(first, items.size(), value));
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    auto count(const vector<T, Alloc, Growth>& items, T value) noexcept -> std::size_t
+    {
+        return detail::count<T>(items.begin().raw(), items.size(), value);
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    auto min(const vector<T, Alloc, Growth>& items) noexcept -> T
+    {
+        return min<T>(items.begin().raw(), items.end().raw());
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    auto max(const vector<T, Alloc, Growth>& items) noexcept -> T
+    {
+        return max<T>(items.begin().raw(), items.end().raw());
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    auto sum(const vector<T, Alloc, Growth>& items) noexcept -> T
+    {
+        return detail::sum<T>(items.begin().raw(), items.size());
+    }
+
+    /**
+     * Returns the dot product of two vectors, only the first
+     * <code>min(lhs.size(), rhs.size())</code> elements take part.
+     * */
+    template <typename T, typename Alloc, typename Growth, typename OtherAlloc, typename OtherGrowth>
+    auto dot(const vector<T, Alloc, Growth>& lhs, const vector<T, OtherAlloc, OtherGrowth>& rhs) noexcept -> T
+    {
+        return detail::dot<T>(lhs.begin().raw(), rhs.begin().raw(), std::min(lhs.size(), rhs.size()));
+    }
+
+} // namespace simd
+
+NAMESPACE_KT_END
+
+#endif // SIMD_HH
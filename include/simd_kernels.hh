@@ -0,0 +1,211 @@
+// Vector kernels behind kt::simd. This file has no include guard on purpose: simd.hh
+// includes it once per instruction set with KT_SIMD_ISA (namespace name) and KT_SIMD_BYTES
+// (register width) defined, inside a region compiled with the matching target options.
+// Do not include it directly.
+
+#if !defined(KT_SIMD_ISA) || !defined(KT_SIMD_BYTES)
+    #error "simd_kernels.hh must only be included from simd.hh"
+#endif
+
+namespace KT_SIMD_ISA {
+
+    template <typename T>
+    struct lanes
+    {
+        typedef T vector_type __attribute__((vector_size(KT_SIMD_BYTES)));
+
+        static constexpr std::size_t count{ KT_SIMD_BYTES / sizeof(T) };
+
+        static inline auto load(vector_type& out, const T* source) noexcept -> void
+        {
+            std::memcpy(&out, source, KT_SIMD_BYTES);
+        }
+
+        template <typename V>
+        static inline auto any(const V& mask) noexcept -> bool
+        {
+            // folding 64 bit words is cheaper than extracting lanes one at a time
+            std::uint64_t words[KT_SIMD_BYTES / sizeof(std::uint64_t)];
+            std::memcpy(words, &mask, KT_SIMD_BYTES);
+
+            std::uint64_t bits{};
+            for (auto word : words)
+                bits |= word;
+
+            return bits != 0;
+        }
+    };
+
+    template <typename T>
+    auto find(const T* first, std::size_t count, T value) noexcept -> const T*
+    {
+        using L = lanes<T>;
+        typename L::vector_type needle{}, a{}, b{}, c{}, d{};
+        needle += value;
+
+        constexpr std::size_t STEP{ L::count * 4 };
+        std::size_t index{};
+
+        for (; index + STEP <= count; index += STEP)
+        {
+            L::load(a, first + index);
+            L::load(b, first + index + L::count);
+            L::load(c, first + index + L::count * 2);
+            L::load(d, first + index + L::count * 3);
+
+            if (L::any((a == needle) | (b == needle) | (c == needle) | (d == needle)))
+                return find_scalar(first + index, STEP, value);
+        }
+
+        return find_scalar(first + index, count - index, value);
+    }
+
+    template <typename T>
+    auto count(const T* first, std::size_t count, T value) noexcept -> std::size_t
+    {
+        using L = lanes<T>;
+        using mask_type = decltype(std::declval<typename L::vector_type>() == std::declval<typename L::vector_type>());
+
+        // lanes count up to CHUNK matches each before being flushed, far from overflowing
+        constexpr std::size_t CHUNK{ std::size_t{ 1 } << 24 };
+
+        typename L::vector_type needle{}, a{};
+        needle += value;
+
+        std::size_t matches{}, index{};
+
+        while (index + L::count <= count)
+        {
+            mask_type hits{};
+            const std::size_t chunk_end{ std::min(count - count % L::count, index + CHUNK * L::count) };
+
+            for (; index < chunk_end; index += L::count)
+            {
+                L::load(a, first + index);
+                hits -= (a == needle);
+            }
+
+            for (std::size_t lane{}; lane < L::count; ++lane)
+                matches += static_cast<std::size_t>(hits[lane]);
+        }
+
+        return matches + count_scalar(first + index, count - index, value);
+    }
+
+    template <typename T>
+    auto min(const T* first, std::size_t count) noexcept -> T
+    {
+        using L = lanes<T>;
+
+        if (count < L::count)
+            return min_scalar(first, count);
+
+        typename L::vector_type result{}, a{};
+        L::load(result, first);
+
+        std::size_t index{ L::count };
+        for (; index + L::count <= count; index += L::count)
+        {
+            L::load(a, first + index);
+            result = a < result ? a : result;
+        }
+
+        T scalar{ result[0] };
+        for (std::size_t lane{ 1 }; lane < L::count; ++lane)
+            scalar = result[lane] < scalar ? result[lane] : scalar;
+
+        for (; index < count; ++index)
+            scalar = first[index] < scalar ? first[index] : scalar;
+
+        return scalar;
+    }
+
+    template <typename T>
+    auto max(const T* first, std::size_t count) noexcept -> T
+    {
+        using L = lanes<T>;
+
+        if (count < L::count)
+            return max_scalar(first, count);
+
+        typename L::vector_type result{}, a{};
+        L::load(result, first);
+
+        std::size_t index{ L::count };
+        for (; index + L::count <= count; index += L::count)
+        {
+            L::load(a, first + index);
+            result = result < a ? a : result;
+        }
+
+        T scalar{ result[0] };
+        for (std::size_t lane{ 1 }; lane < L::count; ++lane)
+            scalar = scalar < result[lane] ? result[lane] : scalar;
+
+        for (; index < count; ++index)
+            scalar = scalar < first[index] ? first[index] : scalar;
+
+        return scalar;
+    }
+
+    template <typename T>
+    auto sum(const T* first, std::size_t count) noexcept -> T
+    {
+        using L = lanes<T>;
+
+        // four independent accumulators hide the latency of the additions
+        typename L::vector_type s0{}, s1{}, s2{}, s3{}, a{}, b{}, c{}, d{};
+
+        constexpr std::size_t STEP{ L::count * 4 };
+        std::size_t index{};
+
+        for (; index + STEP <= count; index += STEP)
+        {
+            L::load(a, first + index);
+            L::load(b, first + index + L::count);
+            L::load(c, first + index + L::count * 2);
+            L::load(d, first + index + L::count * 3);
+            s0 += a;
+            s1 += b;
+            s2 += c;
+            s3 += d;
+        }
+
+        s0 += s1 + s2 + s3;
+
+        T result{ sum_scalar(first + index, count - index) };
+        for (std::size_t lane{}; lane < L::count; ++lane)
+            result += s0[lane];
+
+        return result;
+    }
+
+    template <typename T>
+    auto dot(const T* lhs, const T* rhs, std::size_t count) noexcept -> T
+    {
+        using L = lanes<T>;
+        typename L::vector_type s0{}, s1{}, a{}, b{}, c{}, d{};
+
+        constexpr std::size_t STEP{ L::count * 2 };
+        std::size_t index{};
+
+        for (; index + STEP <= count; index += STEP)
+        {
+            L::load(a, lhs + index);
+            L::load(b, rhs + index);
+            L::load(c, lhs + index + L::count);
+            L::load(d, rhs + index + L::count);
+            s0 += a * b;
+            s1 += c * d;
+        }
+
+        s0 += s1;
+
+        T result{ dot_scalar(lhs + index, rhs + index, count - index) };
+        for (std::size_t lane{}; lane < L::count; ++lane)
+            result += s0[lane];
+
+        return result;
+    }
+
+} // namespace KT_SIMD_ISA
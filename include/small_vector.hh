@@ -0,0 +1,714 @@
+#ifndef SMALL_VECTOR_HH
+#define SMALL_VECTOR_HH
+
+#include "common.hh"
+#include "allocator.hh"
+#include "growth.hh"
+#include "relocate.hh"
+#include "iterator.hh"
+#include "const_iterator.hh"
+
+NAMESPACE_KT_BEG
+
+/**
+ * Resizeable array with the interface of <code>kt::vector</code> that keeps up to
+ * <code>N</code> elements inside the object itself. Storage is only requested from
+ * the allocator once the vector grows past <code>N</code> elements, after which it
+ * behaves like a regular <code>kt::vector</code>.
+ * @tparam T type of the elements
+ * @tparam N number of elements that fit in the inline buffer
+ * @tparam Alloc allocator used once the inline buffer is exhausted
+ * @tparam Growth growth policy for the heap block (see growth.hh), its shrinking is not used
+ * */
+template <typename T, std::size_t N, typename Alloc = allocator<T>, typename Growth = growth::doubling>
+class small_vector
+{
+    static_assert(N > 0, "small_vector needs room for at least one inline element");
+
+    using alloc_traits          = std::allocator_traits<Alloc>;
+
+public:
+    using value_type            = T;
+    using allocator_type        = Alloc;
+    using growth_policy         = Growth;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+    using const_reference_type  = const T&;
+    using iterator_type         = iterator<T>;
+    using const_iterator_type   = const_iterator<T>;
+
+    /**
+     * Default constructs this vector with initial size of 0. The capacity
+     * is that of the inline buffer.
+     * */
+    explicit
+    small_vector() noexcept
+        :   m_array{ inline_data() }, m_count{ 0 }, m_capacity{ N }, m_allocator{}
+    {}
+
+    /**
+     * Constructs an empty vector that will obtain its memory from <code>alloc</code>
+     * once the inline buffer is exhausted.
+     * @param alloc allocator used for every heap allocation of this vector
+     * */
+    explicit
+    small_vector(const allocator_type& alloc) noexcept
+        :   m_array{ inline_data() }, m_count{ 0 }, m_capacity{ N }, m_allocator{ alloc }
+    {}
+
+    /**
+     * Initializes this vector with <code>count</code> copies of
+     * the value <code>value</code>
+     * @param count amount of copies to be made
+     * @param value initial value for ech copy
+     * @param alloc allocator used for every heap allocation of this vector
+     */
+    explicit
+    small_vector(size_type count, const value_type& value = value_type(), const allocator_type& alloc = allocator_type())
+        :   small_vector(alloc)
+    {
+        if (reserve_exact(count))
+        {
+            for (; this->m_count < count; ++(this->m_count))
+                alloc_traits::construct(this->m_allocator, this->m_array + this->m_count, value);
+        }
+    }
+
+    /**
+     * Constructs and initializes this vector with the elements with in the
+     * range of the <b>std::initializer_list</b>.
+     * @param content range of elements to initialize this vector with
+     * @param alloc allocator used for every heap allocation of this vector
+     * */
+    small_vector(std::initializer_list<value_type>&& content, const allocator_type& alloc = allocator_type())
+        :   small_vector(alloc)
+    {
+        if (reserve_exact(content.size()))
+        {
+            for (const auto& item : content)
+                alloc_traits::construct(this->m_allocator, this->m_array + this->m_count++, item);
+        }
+    }
+
+    /**
+     * Initialize this vector with the elements from the range within
+     * first and last (exclusive) iterators, i.e. copies [first, last)
+     * to this vector.
+     * @param first first elements from the range of elements to be copied
+     * @param last last element from the range (not copied)
+     * @param alloc allocator used for every heap allocation of this vector
+     * @tparam InputIterator iterator that allows to read the referenced content
+     * */
+    template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    small_vector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type())
+        :   small_vector(alloc)
+    {
+        if (reserve_exact(static_cast<size_type>(last - first)))
+        {
+            for (; first != last; ++first)
+                alloc_traits::construct(this->m_allocator, this->m_array + this->m_count++, *first);
+        }
+    }
+
+    /**
+     * Initialize this vector with <code>count</code> elements from
+     * range of elements starting at <code>first</code>. If the range contains
+     * less than <code>count</code> elements the behaviour of this method is undefined.
+     * @param first starting point of the range of elements
+     * @param count amount of elements to be copied
+     * @param alloc allocator used for every heap allocation of this vector
+     * @tparam InputIterator iterator that allows to read the referenced content
+     * */
+    template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    small_vector(InputIterator first, size_type count, const allocator_type& alloc = allocator_type())
+        :   small_vector(alloc)
+    {
+        if (reserve_exact(count))
+        {
+            for (; this->m_count < count; ++first)
+                alloc_traits::construct(this->m_allocator, this->m_array + this->m_count++, *first);
+        }
+    }
+
+    /**
+     * Copies contents from <code>other</code> into this vector.
+     * @param other copied from vector
+     * */
+    small_vector(const small_vector& other)
+        :   small_vector(alloc_traits::select_on_container_copy_construction(other.m_allocator))
+    {
+        if (reserve_exact(other.m_count))
+        {
+            for (; this->m_count < other.m_count; ++(this->m_count))
+                alloc_traits::construct(this->m_allocator, this->m_array + this->m_count, other.m_array[this->m_count]);
+        }
+    }
+
+    /**
+     * Copy the contents of <code>other</code> into this vector.
+     * @param other copied from vector
+     * @returns <code>*this</code>
+     * */
+    auto operator=(const small_vector& other) -> small_vector&
+    {
+        if (this != &other)
+        {
+            clear();
+
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+            {
+                if (this->m_allocator != other.m_allocator)
+                    release_heap();
+
+                this->m_allocator = other.m_allocator;
+            }
+
+            if (reserve_exact(other.m_count))
+            {
+                for (; this->m_count < other.m_count; ++(this->m_count))
+                    alloc_traits::construct(this->m_allocator, this->m_array + this->m_count, other.m_array[this->m_count]);
+            }
+        }
+
+        return *this;
+    }
+
+    /**
+     * Moves the contents of the <code>other</code> vector into this vector. Heap storage
+     * changes hands, elements held in the inline buffer of <code>other</code> are relocated
+     * one by one. After this operation <code>other</code> is empty.
+     * @param other moved from vector
+     * */
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<value_type>)
+        :   small_vector(other.m_allocator)
+    {
+        take(other);
+    }
+
+    /**
+     * Moves the contents of the <code>other</code> vector into this vector.
+     * After this operation <code>other</code> is empty.
+     * @param other moved from vector
+     * @returns <code>*this</code>
+     * */
+    auto operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<value_type> &&
+                                                  (alloc_traits::propagate_on_container_move_assignment::value ||
+                                                   alloc_traits::is_always_equal::value)) -> small_vector&
+    {
+        if (this != &other)
+        {
+            clear();
+
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+            {
+                release_heap();
+                this->m_allocator = other.m_allocator;
+            }
+
+            take(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Calls the destructor for all the elements in this vector
+     * and frees the heap buffer of memory if there is one
+     * */
+    ~small_vector()
+    {
+        clear();
+        release_heap();
+    }
+
+    /**
+     * Returns a copy of the allocator associated with this vector.
+     * @returns allocator used by this vector
+     * */
+    [[nodiscard]]
+    auto get_allocator() const noexcept -> allocator_type
+    {
+        return this->m_allocator;
+    }
+
+    /**
+     * Returns a pointer to the block holding the underlying buffer of data
+     * @returns pointer to the underlying block of data
+     * */
+    constexpr auto data() -> pointer_type
+    {
+        return this->m_array;
+    }
+
+    /**
+     * Returns the count of elements in this vector
+     * @returns amount of elements contained within this vector
+     * */
+    [[nodiscard]]
+    auto size() const -> size_type
+    {
+        return this->m_count;
+    }
+
+    /**
+     * Returns the number of elements this vector has space for,
+     * which is never less than <code>N</code>.
+     * @returns capacity of this vector
+     * */
+    [[nodiscard]]
+    auto capacity() const -> size_type
+    {
+        return this->m_capacity;
+    }
+
+    /**
+     * Returns <code>true</code> if this vector has no elements, <code>false</code> otherwise.
+     * @returns if this vector is empty or not
+     * */
+    [[nodiscard]]
+    auto empty() const -> bool
+    {
+        return size() == 0;
+    }
+
+    /**
+     * Returns <code>true</code> while the elements live in the inline buffer.
+     * @returns if this vector has not spilled to the heap
+     * */
+    [[nodiscard]]
+    auto is_inline() const noexcept -> bool
+    {
+        return this->m_array == inline_data();
+    }
+
+    /**
+     * Returns a reference to the element at index <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns reference to the element at the specified index
+     * */
+    [[nodiscard]]
+    auto operator[](size_type index) -> reference_type
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        return this->m_array[index];
+    }
+
+    /**
+     * Returns a constant reference to the element at index <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns reference to the element at the given index
+     * */
+    auto operator[](size_type index) const -> const_reference_type
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        return this->m_array[index];
+    }
+
+    /**
+     * Return reference to element at position <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns reference to the element at the given index
+     * @throws std::runtime_error if this vector is empty or the index is out of bounds
+     * */
+    auto at(size_type index) -> reference_type
+    {
+        if (size() == 0)
+            throw std::runtime_error("This vector has no elements");
+
+        if (index >= size())
+            throw std::out_of_range("Attempting to access an element out of range");
+
+        return (*this)[index];
+    }
+
+    /**
+     * Return constant reference to element at position <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns constant reference to the element at the given index
+     * @throws std::runtime_error if this vector is empty or the index is out of bounds
+     * */
+    auto at(size_type index) const -> const_reference_type
+    {
+        if (size() == 0)
+            throw std::runtime_error("This vector has no elements");
+
+        if (index >= size())
+            throw std::out_of_range("Attempting to access an element out of range");
+
+        return (*this)[index];
+    }
+
+    /**
+     * Reserve a block of memory to hold at least <code>new_count</code> elements.
+     * Has no effect if the container can already hold that many elements.
+     * @param new_count how many elements we may want in this vector
+     * */
+    auto reserve(size_type new_count) -> void
+    {
+        reserve_exact(new_count);
+    }
+
+    /**
+     * After this operation, this vector has <code>count</code> elements. If count is
+     * greater than <code>size()</code> copies of <code>info</code> are appended,
+     * otherwise the trailing elements are destroyed.
+     * @param count number of elements this vector must hold
+     * @param info value the new elements are copied from
+     * */
+    auto resize(size_type count, const value_type& info = value_type()) -> void
+    {
+        if (count < size())
+            remove_n(size() - count);
+        else if (reserve_exact(count))
+            for (; this->m_count < count; ++(this->m_count))
+                alloc_traits::construct(this->m_allocator, this->m_array + this->m_count, info);
+    }
+
+    /**
+     * Construct element in place, in this case, right
+     * at the end of this vector. This function takes the necessary
+     * arguments to construct a new object of the type held by this vector.
+     * @param args arguments to construct the new object
+     * @tparam types of the parameters of this function
+     * */
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> void
+    {
+        if (!grow_for(1))
+            return;
+
+        alloc_traits::construct(this->m_allocator, this->m_array + this->m_count, std::forward<Args>(args)...);
+        ++(this->m_count);
+    }
+
+    /**
+     * Concatenates the contents of this vector and <code>other</code>, i.e. inserts
+     * all the elements of <code>other</code> at the end of this vector.
+     * @param other has the contents to be appended at the end of this vector
+     * */
+    auto append(const small_vector& other) -> void
+    {
+        // geometric growth keeps a loop of appends linear, an exact reservation would reallocate every time
+        if (!other.empty() && grow_for(other.size()))
+        {
+            // other may alias this vector, its size is fixed before copying
+            const size_type count{ other.m_count };
+
+            // counted one by one so the elements copied before a throwing copy are kept and destroyed later
+            for (size_type index{}; index < count; ++index, ++(this->m_count))
+                alloc_traits::construct(this->m_allocator, this->m_array + this->m_count, other.m_array[index]);
+        }
+    }
+
+    /**
+     * Destroy the last <code>count</code> elements from
+     * this vector. If there's  less than <code>count</code> elements,
+     * the effects of this function are the same as <code>clear()</code>.
+     * @param count number of elements to be deleted
+     * */
+    auto remove_n(size_type count) -> void
+    {
+        count = std::min(count, size());
+
+        for (; count != 0; --count)
+            pop_back();
+    }
+
+    /**
+     * Insert <code>elem</code> at the end of this vector.
+     * @param elem new element to be inserted
+     * */
+    auto push_back(const_reference_type elem) -> void
+    {
+        emplace_back(elem);
+    }
+
+    /**
+     * Insert <code>elem</code> at the end of this vector
+     * using move semantics.
+     * @param elem new element
+     * */
+    auto push_back(value_type&& elem) -> void
+    {
+        emplace_back(std::move(elem));
+    }
+
+    /**
+     * Remove the last element of this vector. If this vector is empty this operation has no effect.
+     * */
+    auto pop_back() -> void
+    {
+        if (this->m_count != 0)
+        {
+            alloc_traits::destroy(this->m_allocator, this->m_array + this->m_count - 1);
+            --(this->m_count);
+        }
+    }
+
+    /**
+     * Remove all the elements from this vector. The heap buffer, if any, is kept.
+     * */
+    auto clear() -> void
+    {
+        for (size_type index{}; index < this->m_count; ++index)
+            alloc_traits::destroy(this->m_allocator, this->m_array + index);
+
+        this->m_count = 0;
+    }
+
+    /**
+     * Returns an iterator to the beginning of the vector.
+     * @returns access to the elements at the beginning
+     * */
+    [[nodiscard]]
+    constexpr auto begin() noexcept -> iterator_type
+    {
+        return iterator_type{ this->m_array };
+    }
+
+    /**
+     * Returns an iterator past the last element of the vector.
+     * @returns access to the element past the end of this vector
+     * */
+    [[nodiscard]]
+    constexpr auto end() noexcept -> iterator_type
+    {
+        return iterator_type{ this->m_array + this->m_count };
+    }
+
+    /**
+     * Returns a constant iterator to the beginning of the vector.
+     * @returns read-only access to the elements at the beginning
+     * */
+    [[nodiscard]]
+    constexpr auto begin() const noexcept -> const_iterator_type
+    {
+        return const_iterator_type{ this->m_array };
+    }
+
+    /**
+     * Returns a constant iterator past the last element of the vector.
+     * @returns read-only access to the element past the end of this vector
+     * */
+    [[nodiscard]]
+    constexpr auto end() const noexcept -> const_iterator_type
+    {
+        return const_iterator_type{ this->m_array + this->m_count };
+    }
+
+    /**
+     * Returns a constant iterator to the beginning of the vector.
+     * @returns read-only access to the elements at the beginning
+     * */
+    [[nodiscard]]
+    constexpr auto cbegin() const noexcept -> const_iterator_type
+    {
+        return const_iterator_type{ this->m_array };
+    }
+
+    /**
+     * Returns a constant iterator past the last element of the vector.
+     * @returns read-only access to the element past the end of this vector
+     * */
+    [[nodiscard]]
+    constexpr auto cend() const noexcept -> const_iterator_type
+    {
+        return const_iterator_type{ this->m_array + this->m_count };
+    }
+
+    /**
+     * Returns a reference to the first element of this vector.
+     * @returns front element
+     * */
+    [[nodiscard]]
+    auto front() noexcept -> reference_type
+    {
+#if !defined(NDEBUG)
+        assert(!empty() && "Attempting to retrieve front element of empty vector");
+#endif
+        return *this->m_array;
+    }
+
+    /**
+     * Returns a reference to the last element of this vector.
+     * @return last element
+     * */
+    auto back() noexcept -> reference_type
+    {
+#if !defined(NDEBUG)
+        assert(!empty() && "Attempting to retrieve back element of empty vector");
+#endif
+        return *(this->m_array + this->m_count - 1);
+    }
+
+    /**
+     * Returns a constant reference to the first element of this vector.
+     * @return front element
+     * */
+    auto front() const noexcept -> const_reference_type
+    {
+#if !defined(NDEBUG)
+        assert(!empty() && "Attempting to retrieve front element of empty vector");
+#endif
+        return *this->m_array;
+    }
+
+    /**
+     * Returns a constant reference to the last element of this vector.
+     * @returns last element
+     * */
+    auto back() const noexcept -> const_reference_type
+    {
+#if !defined(NDEBUG)
+        assert(!empty() && "Attempting to retrieve back element of empty vector");
+#endif
+        return *(this->m_array + this->m_count - 1);
+    }
+
+private:
+    auto inline_data() noexcept -> pointer_type
+    {
+        return std::launder(reinterpret_cast<pointer_type>(this->m_inline));
+    }
+
+    auto inline_data() const noexcept -> const value_type*
+    {
+        return std::launder(reinterpret_cast<const value_type*>(this->m_inline));
+    }
+
+    /**
+     * Makes room for <code>extra</code> more elements, growing as the growth policy dictates
+     * but never less than needed.
+     * @returns <code>true</code> if <code>extra</code> elements can be added without reallocating
+     * */
+    auto grow_for(size_type extra) -> bool
+    {
+        const size_type required{ this->m_count + extra };
+
+        if (required <= this->m_capacity)
+            return true;
+
+        return reallocate_to(std::max(required, growth_policy::next_capacity(this->m_capacity, required, sizeof(value_type))));
+    }
+
+    auto reserve_exact(size_type new_count) -> bool
+    {
+        return new_count <= capacity() || reallocate_to(new_count);
+    }
+
+    /**
+     * Moves the elements to a heap block of <code>new_block_count</code> elements. The first
+     * spill out of the inline buffer always relocates, further growth may resize the heap
+     * block in place the same way <code>kt::vector</code> does.
+     * On failure this vector is left untouched.
+     * */
+    auto reallocate_to(size_type new_block_count) -> bool
+    {
+        pointer_type new_block{ nullptr };
+        new_block_count = growth_policy::round_capacity(new_block_count, sizeof(value_type));
+
+        if constexpr (detail::relocation_for<value_type, allocator_type> == detail::relocation::realloc)
+        {
+            if (!is_inline())
+                new_block = this->m_allocator.reallocate(this->m_array, this->m_capacity, new_block_count);
+        }
+
+        if (new_block == nullptr && (is_inline() ||
+            detail::relocation_for<value_type, allocator_type> != detail::relocation::realloc))
+        {
+            new_block = alloc_traits::allocate(this->m_allocator, new_block_count);
+
+            if (new_block != nullptr)
+            {
+                try
+                {
+                    detail::relocate(this->m_allocator, this->m_array, this->m_count, new_block);
+                }
+                catch (...)
+                {
+                    alloc_traits::deallocate(this->m_allocator, new_block, new_block_count);
+                    throw;
+                }
+
+                release_heap();
+            }
+        }
+
+        if (new_block == nullptr)
+        {
+#if !defined(NDEBUG)
+            std::printf("Failed to allocate new block of memory");
+#endif
+            return false;
+        }
+
+        if constexpr (growth_policy::use_usable_size && detail::has_usable_size_v<allocator_type>)
+            new_block_count = this->m_allocator.usable_size(new_block, new_block_count);
+
+        this->m_array = new_block;
+        this->m_capacity = new_block_count;
+
+        return true;
+    }
+
+    /**
+     * Frees the heap block, if any, and points this vector back to its inline buffer.
+     * Must only be called once the elements have been destroyed or relocated.
+     * */
+    auto release_heap() noexcept -> void
+    {
+        if (!is_inline())
+            alloc_traits::deallocate(this->m_allocator, this->m_array, this->m_capacity);
+
+        this->m_array = inline_data();
+        this->m_capacity = N;
+    }
+
+    /**
+     * Takes the elements of <code>other</code>, which is left empty. This vector must be empty.
+     * */
+    auto take(small_vector& other) -> void
+    {
+        if (!other.is_inline() && this->m_allocator == other.m_allocator)
+        {
+            release_heap();
+
+            this->m_array = other.m_array;
+            this->m_count = other.m_count;
+            this->m_capacity = other.m_capacity;
+
+            other.m_array = other.inline_data();
+            other.m_count = 0;
+            other.m_capacity = N;
+        }
+        else if (reserve_exact(other.m_count))
+        {
+            detail::relocate(this->m_allocator, other.m_array, other.m_count, this->m_array);
+            this->m_count = other.m_count;
+            other.m_count = 0;
+        }
+    }
+
+    pointer_type    m_array;
+    size_type       m_count;
+    size_type       m_capacity;
+    allocator_type  m_allocator;
+    alignas(value_type) unsigned char m_inline[sizeof(value_type) * N];
+
+    /**
+     * <h3>CONSTRAINTS: m_capacity >= m_count >= 0, m_capacity >= N</h3>
+     *
+     * <p><code>m_array</code> points either to <code>m_inline</code> or to a heap block owned by this vector</br></p>
+     * <p><code>m_capacity</code> equals <code>N</code> exactly while <code>m_array</code> points to <code>m_inline</code></br></p>
+     * */
+
+};  // CLASS SMALL_VECTOR
+
+NAMESPACE_KT_END   // END KT NAMESPACE
+
+#endif // SMALL_VECTOR_HH
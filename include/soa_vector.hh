@@ -0,0 +1,533 @@
+#ifndef SOA_VECTOR_HH
+#define SOA_VECTOR_HH
+
+#include <tuple>
+#include <cstdio>
+
+#include "common.hh"
+#include "allocator.hh"
+#include "relocate.hh"
+#include "growth.hh"
+#include "span.hh"
+
+NAMESPACE_KT_BEG
+
+/**
+ * Structure of arrays container: the i-th element is made of one value per column
+ * (<code>Ts...</code>) and every column is a contiguous array of its own. Loops touching a
+ * few fields read only those columns, so every cache line fetched is full of useful data
+ * and field scans over <code>column&lt;I&gt;()</code> vectorize like loops over plain arrays.
+ *
+ * <p>All the columns share one size and one capacity and grow together, the capacity being
+ * decided by <code>Growth</code> exactly like for <code>kt::vector</code> (with the size of a whole
+ * row as element size). Columns are relocated with the same rules as <code>kt::vector</code>, so
+ * trivially relocatable fields are moved with <code>memcpy()</code>.</p>
+ * @tparam Growth policy deciding the capacity of the columns
+ * @tparam Ts type of each column
+ * */
+template <typename Growth, typename... Ts>
+class basic_soa_vector
+{
+    static_assert(sizeof...(Ts) > 0, "a soa_vector needs at least one column");
+    static_assert((std::is_nothrow_move_constructible_v<Ts> && ...),
+        "columns are relocated one after another and cannot be rolled back, their moves must not throw");
+
+    using columns_type          = std::tuple<Ts*...>;
+    using indices_type          = std::index_sequence_for<Ts...>;
+
+public:
+    using growth_policy         = Growth;
+    using size_type             = std::size_t;
+    using reference_type        = std::tuple<Ts&...>;
+    using const_reference_type  = std::tuple<const Ts&...>;
+
+    template <size_type I>
+    using column_type           = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    static constexpr size_type row_size{ (sizeof(Ts) + ...) };
+
+    /**
+     * Iterator visiting the rows of the vector. Dereferencing yields a tuple of references to
+     * the fields of a row, which supports structured bindings: <code>for (auto [id, value] : items)</code>.
+     * Since that tuple is a proxy and not a real reference the iterator is only tagged as an
+     * input iterator, so standard algorithms never assume they can keep references to rows;
+     * it still offers the random access arithmetic for direct use.
+     * */
+    template <bool Const>
+    class basic_iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type   = std::ptrdiff_t;
+        using value_type        = std::tuple<Ts...>;
+        using reference         = std::conditional_t<Const, const_reference_type, reference_type>;
+        using pointer           = void;
+        using owner_type        = std::conditional_t<Const, const basic_soa_vector, basic_soa_vector>;
+
+        basic_iterator() noexcept = default;
+
+        basic_iterator(owner_type* owner, size_type index) noexcept
+            :   m_owner{ owner }, m_index{ index }
+        {}
+
+        auto operator*() const -> reference { return (*this->m_owner)[this->m_index]; }
+        auto operator[](difference_type offset) const -> reference { return (*this->m_owner)[this->m_index + offset]; }
+
+        auto operator++() noexcept -> basic_iterator& { ++this->m_index; return *this; }
+        auto operator--() noexcept -> basic_iterator& { --this->m_index; return *this; }
+        auto operator++(int) noexcept -> basic_iterator { return basic_iterator{ this->m_owner, this->m_index++ }; }
+        auto operator--(int) noexcept -> basic_iterator { return basic_iterator{ this->m_owner, this->m_index-- }; }
+
+        auto operator+=(difference_type offset) noexcept -> basic_iterator& { this->m_index += offset; return *this; }
+        auto operator-=(difference_type offset) noexcept -> basic_iterator& { this->m_index -= offset; return *this; }
+        auto operator+(difference_type offset) const noexcept -> basic_iterator { return basic_iterator{ this->m_owner, this->m_index + offset }; }
+        auto operator-(difference_type offset) const noexcept -> basic_iterator { return basic_iterator{ this->m_owner, this->m_index - offset }; }
+
+        friend auto operator+(difference_type offset, const basic_iterator& iterator) noexcept -> basic_iterator
+        {
+            return iterator + offset;
+        }
+
+        friend auto operator-(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> difference_type
+        {
+            return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+        }
+
+        friend auto operator==(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index == rhs.m_index; }
+        friend auto operator!=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index != rhs.m_index; }
+        friend auto operator<(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index < rhs.m_index; }
+        friend auto operator>(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index > rhs.m_index; }
+        friend auto operator<=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index <= rhs.m_index; }
+        friend auto operator>=(const basic_iterator& lhs, const basic_iterator& rhs) noexcept -> bool { return lhs.m_index >= rhs.m_index; }
+
+    private:
+        owner_type* m_owner{ nullptr };
+        size_type   m_index{ 0 };
+    };
+
+    using iterator_type         = basic_iterator<false>;
+    using const_iterator_type   = basic_iterator<true>;
+
+    /**
+     * Constructs an empty vector, no column is allocated.
+     * */
+    basic_soa_vector() noexcept = default;
+
+    /**
+     * Copies every column of <code>other</code>, the capacity of the copy is its size.
+     * @param other vector to be copied
+     * */
+    basic_soa_vector(const basic_soa_vector& other)
+    {
+        if (other.m_count == 0)
+            return;
+
+        columns_type columns{};
+
+        if (!allocate_columns(columns, other.m_count, indices_type{}))
+        {
+#if !defined(NDEBUG)
+            std::printf("could not allocate block of memory...");
+#endif
+            return;
+        }
+
+        try
+        {
+            copy_columns(columns, other, indices_type{});
+        }
+        catch (...)
+        {
+            deallocate_columns(columns, other.m_count, indices_type{});
+            throw;
+        }
+
+        this->m_columns = columns;
+        this->m_count = other.m_count;
+        this->m_capacity = other.m_count;
+    }
+
+    basic_soa_vector(basic_soa_vector&& other) noexcept
+        :   m_columns{ std::exchange(other.m_columns, columns_type{}) }
+        ,   m_count{ std::exchange(other.m_count, 0) }
+        ,   m_capacity{ std::exchange(other.m_capacity, 0) }
+    {}
+
+    auto operator=(const basic_soa_vector& other) -> basic_soa_vector&
+    {
+        if (this != &other)
+            *this = basic_soa_vector{ other };
+
+        return *this;
+    }
+
+    auto operator=(basic_soa_vector&& other) noexcept -> basic_soa_vector&
+    {
+        if (this != &other)
+        {
+            release();
+
+            this->m_columns = std::exchange(other.m_columns, columns_type{});
+            this->m_count = std::exchange(other.m_count, 0);
+            this->m_capacity = std::exchange(other.m_capacity, 0);
+        }
+
+        return *this;
+    }
+
+    ~basic_soa_vector()
+    {
+        release();
+    }
+
+    [[nodiscard]]
+    auto size() const noexcept -> size_type
+    {
+        return this->m_count;
+    }
+
+    [[nodiscard]]
+    auto capacity() const noexcept -> size_type
+    {
+        return this->m_capacity;
+    }
+
+    [[nodiscard]]
+    auto empty() const noexcept -> bool
+    {
+        return this->m_count == 0;
+    }
+
+    /**
+     * Returns a view over the column <code>I</code>, valid until the vector reallocates.
+     * @tparam I index of the column
+     * @returns span over the <code>size()</code> values of the column
+     * */
+    template <size_type I>
+    [[nodiscard]]
+    auto column() noexcept -> span<column_type<I>>
+    {
+        return { std::get<I>(this->m_columns), this->m_count };
+    }
+
+    template <size_type I>
+    [[nodiscard]]
+    auto column() const noexcept -> span<const column_type<I>>
+    {
+        return { std::get<I>(this->m_columns), this->m_count };
+    }
+
+    /**
+     * Returns the field <code>I</code> of the row at <code>index</code>.
+     * */
+    template <size_type I>
+    [[nodiscard]]
+    auto get(size_type index) -> column_type<I>&
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        return std::get<I>(this->m_columns)[index];
+    }
+
+    template <size_type I>
+    [[nodiscard]]
+    auto get(size_type index) const -> const column_type<I>&
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        return std::get<I>(this->m_columns)[index];
+    }
+
+    /**
+     * Returns references to every field of the row at <code>index</code>.
+     * @param index index of the row
+     * @returns tuple of references to the fields of the row
+     * */
+    [[nodiscard]]
+    auto operator[](size_type index) -> reference_type
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        return std::apply([index](Ts*... columns) -> reference_type { return reference_type{ columns[index]... }; },
+                          this->m_columns);
+    }
+
+    [[nodiscard]]
+    auto operator[](size_type index) const -> const_reference_type
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        return std::apply([index](Ts*... columns) -> const_reference_type { return const_reference_type{ columns[index]... }; },
+                          this->m_columns);
+    }
+
+    /**
+     * Makes room for at least <code>new_count</code> rows.
+     * @param new_count number of rows to make room for
+     * */
+    auto reserve(size_type new_count) -> void
+    {
+        if (new_count > this->m_capacity)
+            reallocate_to(new_count);
+    }
+
+    /**
+     * Appends a row whose field <code>i</code> is constructed from the argument <code>i</code>.
+     * @param args one argument per column
+     * */
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> void
+    {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back takes exactly one argument per column");
+
+        if (this->m_count == this->m_capacity &&
+            !reallocate_to(growth_policy::next_capacity(this->m_capacity, this->m_count + 1, row_size)))
+        {
+#if !defined(NDEBUG)
+            std::printf("could not insert new element due to error while reallocating...");
+#endif
+            return;
+        }
+
+        construct_row(this->m_count, indices_type{}, std::forward<Args>(args)...);
+        ++(this->m_count);
+    }
+
+    auto push_back(const Ts&... values) -> void
+    {
+        emplace_back(values...);
+    }
+
+    /**
+     * Changes the number of rows to <code>count</code>, new rows are value initialized.
+     * @param count number of rows this vector must hold
+     * */
+    auto resize(size_type count) -> void
+    {
+        if (count <= this->m_count)
+        {
+            destroy_rows(count, indices_type{});
+            this->m_count = count;
+            return;
+        }
+
+        if (count > this->m_capacity &&
+            !reallocate_to(std::max(count, growth_policy::next_capacity(this->m_capacity, count, row_size))))
+            return;
+
+        for (; this->m_count < count; ++(this->m_count))
+            construct_row(this->m_count, indices_type{});
+    }
+
+    auto pop_back() -> void
+    {
+        if (this->m_count != 0)
+        {
+            destroy_rows(this->m_count - 1, indices_type{});
+            --(this->m_count);
+        }
+    }
+
+    auto clear() noexcept -> void
+    {
+        destroy_rows(0, indices_type{});
+        this->m_count = 0;
+    }
+
+    auto begin() noexcept -> iterator_type { return iterator_type{ this, 0 }; }
+    auto end() noexcept -> iterator_type { return iterator_type{ this, this->m_count }; }
+    auto begin() const noexcept -> const_iterator_type { return const_iterator_type{ this, 0 }; }
+    auto end() const noexcept -> const_iterator_type { return const_iterator_type{ this, this->m_count }; }
+    auto cbegin() const noexcept -> const_iterator_type { return begin(); }
+    auto cend() const noexcept -> const_iterator_type { return end(); }
+
+private:
+    template <typename T>
+    using alloc_traits = std::allocator_traits<allocator<T>>;
+
+    template <size_type... Is>
+    static auto allocate_columns(columns_type& columns, size_type count, std::index_sequence<Is...>) -> bool
+    {
+        bool complete{ true };
+
+        // stop at the first failure, columns after it stay null
+        static_cast<void>(((std::get<Is>(columns) = alloc_column<column_type<Is>>(count),
+                            complete = std::get<Is>(columns) != nullptr) && ...));
+
+        if (!complete)
+            deallocate_columns(columns, count, std::index_sequence<Is...>{});
+
+        return complete;
+    }
+
+    template <size_type... Is>
+    static auto deallocate_columns(columns_type& columns, size_type count, std::index_sequence<Is...>) noexcept -> void
+    {
+        (dealloc_column(std::get<Is>(columns), count), ...);
+        columns = columns_type{};
+    }
+
+    template <typename T>
+    static auto alloc_column(size_type count) -> T*
+    {
+        allocator<T> alloc{};
+        return alloc_traits<T>::allocate(alloc, count);
+    }
+
+    template <typename T>
+    static auto dealloc_column(T* column, size_type count) noexcept -> void
+    {
+        if (column != nullptr)
+        {
+            allocator<T> alloc{};
+            alloc_traits<T>::deallocate(alloc, column, count);
+        }
+    }
+
+    template <size_type... Is>
+    auto copy_columns(columns_type& columns, const basic_soa_vector& other, std::index_sequence<Is...>) -> void
+    {
+        size_type completed{};
+
+        try
+        {
+            ((copy_column(std::get<Is>(columns), std::get<Is>(other.m_columns), other.m_count), ++completed), ...);
+        }
+        catch (...)
+        {
+            // the column that threw cleaned up after itself
+            ((Is < completed ? destroy_column(std::get<Is>(columns), other.m_count) : void()), ...);
+            throw;
+        }
+    }
+
+    template <typename T>
+    static auto copy_column(T* destination, const T* source, size_type count) -> void
+    {
+        size_type built{};
+
+        try
+        {
+            for (; built < count; ++built)
+                alloc_construct(destination + built, source[built]);
+        }
+        catch (...)
+        {
+            destroy_column(destination, built);
+            throw;
+        }
+    }
+
+    template <typename T>
+    static auto destroy_column(T* column, size_type count) noexcept -> void
+    {
+        for (size_type index{}; index < count; ++index)
+            alloc_destroy(column + index);
+    }
+
+    template <size_type... Is, typename... Args>
+    auto construct_row(size_type index, std::index_sequence<Is...>, Args&&... args) -> void
+    {
+        size_type built{};
+
+        try
+        {
+            if constexpr (sizeof...(Args) == 0)
+                ((alloc_construct(std::get<Is>(this->m_columns) + index), ++built), ...);
+            else
+                ((alloc_construct(std::get<Is>(this->m_columns) + index, std::forward<Args>(args)), ++built), ...);
+        }
+        catch (...)
+        {
+            ((Is < built ? alloc_destroy(std::get<Is>(this->m_columns) + index) : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_type... Is>
+    auto destroy_rows(size_type first, std::index_sequence<Is...>) noexcept -> void
+    {
+        for (size_type index{ first }; index < this->m_count; ++index)
+            (alloc_destroy(std::get<Is>(this->m_columns) + index), ...);
+    }
+
+    template <typename T, typename... Args>
+    static auto alloc_construct(T* slot, Args&&... args) -> void
+    {
+        allocator<T> alloc{};
+        alloc_traits<T>::construct(alloc, slot, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static auto alloc_destroy(T* slot) noexcept -> void
+    {
+        allocator<T> alloc{};
+        alloc_traits<T>::destroy(alloc, slot);
+    }
+
+    /**
+     * Moves every column to blocks able to hold <code>new_block_count</code> rows. All the new
+     * blocks are allocated before any element moves, so on failure this vector is left untouched.
+     * */
+    auto reallocate_to(size_type new_block_count) -> bool
+    {
+        new_block_count = growth_policy::round_capacity(new_block_count, row_size);
+
+        columns_type columns{};
+
+        if (!allocate_columns(columns, new_block_count, indices_type{}))
+        {
+#if !defined(NDEBUG)
+            std::printf("Failed to allocate new block of memory");
+#endif
+            return false;
+        }
+
+        relocate_columns(columns, indices_type{});
+
+        this->m_columns = columns;
+        this->m_capacity = new_block_count;
+
+        return true;
+    }
+
+    template <size_type... Is>
+    auto relocate_columns(columns_type& columns, std::index_sequence<Is...>) noexcept -> void
+    {
+        (relocate_column(std::get<Is>(this->m_columns), std::get<Is>(columns)), ...);
+    }
+
+    template <typename T>
+    auto relocate_column(T* source, T* destination) noexcept -> void
+    {
+        allocator<T> alloc{};
+        detail::relocate(alloc, source, this->m_count, destination);
+        dealloc_column(source, this->m_capacity);
+    }
+
+    auto release() noexcept -> void
+    {
+        clear();
+        deallocate_columns(this->m_columns, this->m_capacity, indices_type{});
+        this->m_capacity = 0;
+    }
+
+    columns_type    m_columns{};
+    size_type       m_count{ 0 };
+    size_type       m_capacity{ 0 };
+};
+
+/**
+ * Structure of arrays vector growing like <code>kt::vector</code> with its default policy.
+ * @tparam Ts type of each column
+ * */
+template <typename... Ts>
+using soa_vector = basic_soa_vector<growth::doubling, Ts...>;
+
+NAMESPACE_KT_END
+
+#endif // SOA_VECTOR_HH
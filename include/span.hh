@@ -0,0 +1,100 @@
+#ifndef SPAN_HH
+#define SPAN_HH
+
+#include "common.hh"
+
+NAMESPACE_KT_BEG
+
+/**
+ * Non owning view over <code>count</code> contiguous objects of type <code>T</code>, the C++17
+ * counterpart of <code>std::span&lt;T&gt;</code>. Its iterators are raw pointers, so loops over
+ * a span are as easy to vectorize for the compiler as loops over a plain array.
+ * @tparam T type of the viewed objects, <code>const</code> qualified for read only views
+ * */
+template <typename T>
+class span
+{
+public:
+    using element_type          = T;
+    using value_type            = std::remove_cv_t<T>;
+    using size_type             = std::size_t;
+    using pointer_type          = T*;
+    using reference_type        = T&;
+    using iterator_type         = T*;
+
+    constexpr span() noexcept = default;
+
+    constexpr span(pointer_type data, size_type count) noexcept
+        :   m_data{ data }, m_count{ count }
+    {}
+
+    /**
+     * Converts a view over <code>U</code> into a view over <code>T</code>, e.g. <code>span&lt;int&gt;</code>
+     * into <code>span&lt;const int&gt;</code>.
+     * */
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U(*)[], T(*)[]>>>
+    constexpr span(const span<U>& other) noexcept
+        :   m_data{ other.data() }, m_count{ other.size() }
+    {}
+
+    [[nodiscard]] constexpr auto data() const noexcept -> pointer_type { return this->m_data; }
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type { return this->m_count; }
+    [[nodiscard]] constexpr auto size_bytes() const noexcept -> size_type { return this->m_count * sizeof(T); }
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return this->m_count == 0; }
+
+    constexpr auto operator[](size_type index) const -> reference_type
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        return this->m_data[index];
+    }
+
+    constexpr auto front() const -> reference_type { return (*this)[0]; }
+    constexpr auto back() const -> reference_type { return (*this)[size() - 1]; }
+
+    constexpr auto begin() const noexcept -> iterator_type { return this->m_data; }
+    constexpr auto end() const noexcept -> iterator_type { return this->m_data + this->m_count; }
+
+    /**
+     * Returns a view over the first <code>count</code> objects of this span.
+     * */
+    constexpr auto first(size_type count) const -> span
+    {
+#if !defined(NDEBUG)
+        assert(count <= size() && "Sub span exceeds the viewed range");
+#endif
+        return span{ this->m_data, count };
+    }
+
+    /**
+     * Returns a view over the last <code>count</code> objects of this span.
+     * */
+    constexpr auto last(size_type count) const -> span
+    {
+#if !defined(NDEBUG)
+        assert(count <= size() && "Sub span exceeds the viewed range");
+#endif
+        return span{ this->m_data + (this->m_count - count), count };
+    }
+
+    /**
+     * Returns a view over <code>count</code> objects starting at <code>offset</code>,
+     * or over every object past <code>offset</code> if <code>count</code> is not given.
+     * */
+    constexpr auto subspan(size_type offset, size_type count = static_cast<size_type>(-1)) const -> span
+    {
+#if !defined(NDEBUG)
+        assert(offset <= size() && "Sub span exceeds the viewed range");
+#endif
+        return span{ this->m_data + offset, std::min(count, this->m_count - offset) };
+    }
+
+private:
+    pointer_type    m_data{ nullptr };
+    size_type       m_count{ 0 };
+};
+
+NAMESPACE_KT_END
+
+#endif // SPAN_HH
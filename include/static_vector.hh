@@ -0,0 +1,704 @@
+#ifndef STATIC_VECTOR_HH
+#define STATIC_VECTOR_HH
+
+#include "common.hh"
+#include "relocate.hh"
+#include "iterator.hh"
+#include "const_iterator.hh"
+
+NAMESPACE_KT_BEG
+
+namespace detail {
+
+    /**
+     * Smallest unsigned integer able to count up to <code>N</code>, keeping small
+     * fixed capacity vectors (e.g. packet headers) as compact as possible.
+     * */
+    template <std::size_t N>
+    using static_count_t = std::conditional_t<N <= 0xFFu, std::uint8_t,
+                           std::conditional_t<N <= 0xFFFFu, std::uint16_t,
+                           std::conditional_t<N <= 0xFFFFFFFFu, std::uint32_t, std::size_t>>>;
+
+    /**
+     * Inline storage of <code>static_vector</code>. For trivially copyable elements every special
+     * member is defaulted, so the vector is trivially copyable as well and copies are plain
+     * memcpys of the whole object. Other elements are copied, moved and destroyed one by one
+     * by the specialization below.
+     * */
+    template <typename T, std::size_t N, bool = std::is_trivially_copyable_v<T>>
+    class static_storage
+    {
+    protected:
+        alignas(T) unsigned char    m_storage[sizeof(T) * N];
+        static_count_t<N>           m_count{ 0 };
+    };
+
+    template <typename T, std::size_t N>
+    class static_storage<T, N, false>
+    {
+    protected:
+        static_storage() noexcept = default;
+
+        static_storage(const static_storage& other)
+        {
+            try
+            {
+                append_copies(other);
+            }
+            catch (...)
+            {
+                // no destructor runs for a partially constructed object
+                destroy_from(0);
+                throw;
+            }
+        }
+
+        static_storage(static_storage&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            take(other);
+        }
+
+        auto operator=(const static_storage& other) -> static_storage&
+        {
+            if (this != &other)
+            {
+                // assign over live elements, then build or destroy the difference
+                const std::size_t common{ std::min<std::size_t>(this->m_count, other.m_count) };
+                std::copy(other.slots(), other.slots() + common, slots());
+
+                if (other.m_count > this->m_count)
+                    append_copies(other);
+                else
+                    destroy_from(other.m_count);
+            }
+
+            return *this;
+        }
+
+        auto operator=(static_storage&& other) noexcept(std::is_nothrow_move_constructible_v<T>) -> static_storage&
+        {
+            if (this != &other)
+            {
+                destroy_from(0);
+                take(other);
+            }
+
+            return *this;
+        }
+
+        ~static_storage()
+        {
+            destroy_from(0);
+        }
+
+        alignas(T) unsigned char    m_storage[sizeof(T) * N];
+        static_count_t<N>           m_count{ 0 };
+
+    private:
+        auto slots() noexcept -> T*
+        {
+            return std::launder(reinterpret_cast<T*>(this->m_storage));
+        }
+
+        auto slots() const noexcept -> const T*
+        {
+            return std::launder(reinterpret_cast<const T*>(this->m_storage));
+        }
+
+        /**
+         * Copy constructs the elements of <code>other</code> past the ones of this vector.
+         * */
+        auto append_copies(const static_storage& other) -> void
+        {
+            for (; this->m_count < other.m_count; ++(this->m_count))
+                ::new (static_cast<void*>(slots() + this->m_count)) T(other.slots()[this->m_count]);
+        }
+
+        auto destroy_from(std::size_t count) noexcept -> void
+        {
+            for (std::size_t index{ count }; index < this->m_count; ++index)
+                std::destroy_at(slots() + index);
+
+            this->m_count = static_cast<static_count_t<N>>(count);
+        }
+
+        /**
+         * Moves the elements of <code>other</code> into this empty vector, leaving <code>other</code> empty.
+         * */
+        auto take(static_storage& other) -> void
+        {
+            std::allocator<T> alloc{};
+            relocate(alloc, other.slots(), other.m_count, slots());
+
+            this->m_count = other.m_count;
+            other.m_count = 0;
+        }
+    };
+
+} // namespace detail
+
+/**
+ * Vector with the interface of <code>kt::vector</code> whose elements live inside the object,
+ * in room for exactly <code>N</code> of them: it never allocates. Appending to a full vector
+ * has no effect, <code>try_push_back()</code> and <code>try_emplace_back()</code> report it.
+ * When <code>T</code> is trivially copyable so is the vector, which can then be memcpy'd,
+ * sent over the wire or stored in shared memory as is.
+ * @tparam T type of the elements
+ * @tparam N maximum number of elements
+ * */
+template <typename T, std::size_t N>
+class static_vector : private detail::static_storage<T, N>
+{
+    static_assert(N > 0, "static_vector needs room for at least one element");
+
+    using count_type            = detail::static_count_t<N>;
+
+public:
+    using value_type            = T;
+    using size_type             = std::size_t;
+    using reference_type        = T&;
+    using pointer_type          = T*;
+    using const_reference_type  = const T&;
+    using iterator_type         = iterator<T>;
+    using const_iterator_type   = const_iterator<T>;
+
+    /**
+     * Default constructs this vector with initial size of 0.
+     * */
+    static_vector() noexcept = default;
+
+    /**
+     * Initializes this vector with <code>count</code> copies of the value <code>value</code>.
+     * At most <code>N</code> copies are made.
+     * @param count amount of copies to be made
+     * @param value initial value for each copy
+     * */
+    explicit
+    static_vector(size_type count, const value_type& value = value_type())
+    {
+        resize(count, value);
+    }
+
+    /**
+     * Constructs and initializes this vector with the elements with in the
+     * range of the <b>std::initializer_list</b>. At most <code>N</code> are kept.
+     * @param content range of elements to initialize this vector with
+     * */
+    static_vector(std::initializer_list<value_type> content)
+        :   static_vector(content.begin(), content.end())
+    {}
+
+    /**
+     * Initialize this vector with the elements from the range within first and last
+     * (exclusive) iterators. At most <code>N</code> are copied.
+     * @param first first elements from the range of elements to be copied
+     * @param last last element from the range (not copied)
+     * @tparam InputIterator iterator that allows to read the referenced content
+     * */
+    template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    static_vector(InputIterator first, InputIterator last)
+    {
+        for (; first != last && !full(); ++first)
+            unchecked_emplace_back(*first);
+
+#if !defined(NDEBUG)
+        if (first != last)
+            std::printf("static_vector is full, the rest of the range was dropped...");
+#endif
+    }
+
+    static_vector(const static_vector&) = default;
+    static_vector(static_vector&&) = default;
+    auto operator=(const static_vector&) -> static_vector& = default;
+    auto operator=(static_vector&&) -> static_vector& = default;
+    ~static_vector() = default;
+
+    /**
+     * Returns a pointer to the first element.
+     * @returns pointer to the underlying storage
+     * */
+    auto data() noexcept -> pointer_type
+    {
+        return slots();
+    }
+
+    auto data() const noexcept -> const value_type*
+    {
+        return slots();
+    }
+
+    /**
+     * Returns the count of elements in this vector
+     * @returns amount of elements contained within this vector
+     * */
+    [[nodiscard]]
+    auto size() const noexcept -> size_type
+    {
+        return this->m_count;
+    }
+
+    /**
+     * Returns the number of elements this vector has room for, always <code>N</code>.
+     * @returns capacity of this vector
+     * */
+    [[nodiscard]]
+    static constexpr auto capacity() noexcept -> size_type
+    {
+        return N;
+    }
+
+    /**
+     * Returns <code>true</code> if this vector has no elements, <code>false</code> otherwise.
+     * @returns if this vector is empty or not
+     * */
+    [[nodiscard]]
+    auto empty() const noexcept -> bool
+    {
+        return this->m_count == 0;
+    }
+
+    /**
+     * Returns <code>true</code> if this vector holds <code>N</code> elements.
+     * @returns if no element can be added
+     * */
+    [[nodiscard]]
+    auto full() const noexcept -> bool
+    {
+        return this->m_count == N;
+    }
+
+    /**
+     * Returns a reference to the element at index <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns reference to the element at the specified index
+     * */
+    [[nodiscard]]
+    auto operator[](size_type index) -> reference_type
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        return slots()[index];
+    }
+
+    /**
+     * Returns a constant reference to the element at index <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns reference to the element at the given index
+     * */
+    auto operator[](size_type index) const -> const_reference_type
+    {
+#if !defined(NDEBUG)
+        assert(index < size() && "Attempting to access out of bounds element...");
+#endif
+        return slots()[index];
+    }
+
+    /**
+     * Return reference to element at position <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns reference to the element at the given index
+     * @throws std::out_of_range if the index is out of bounds
+     * */
+    auto at(size_type index) -> reference_type
+    {
+        if (index >= size())
+            throw std::out_of_range("Attempting to access an element out of range");
+
+        return (*this)[index];
+    }
+
+    /**
+     * Return constant reference to element at position <code>index</code>.
+     * @param index index of the element to be returned
+     * @returns constant reference to the element at the given index
+     * @throws std::out_of_range if the index is out of bounds
+     * */
+    auto at(size_type index) const -> const_reference_type
+    {
+        if (index >= size())
+            throw std::out_of_range("Attempting to access an element out of range");
+
+        return (*this)[index];
+    }
+
+    /**
+     * Construct element in place at the end of this vector, unless it is full.
+     * @param args arguments to construct the new object
+     * @returns pointer to the new element, or <code>nullptr</code> if this vector is full
+     * @tparam Args types of the parameters of this function
+     * */
+    template <typename... Args>
+    auto try_emplace_back(Args&&... args) -> pointer_type
+    {
+        if (full())
+            return nullptr;
+
+        return std::addressof(unchecked_emplace_back(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Insert <code>elem</code> at the end of this vector, unless it is full.
+     * @param elem new element to be inserted
+     * @returns pointer to the new element, or <code>nullptr</code> if this vector is full
+     * */
+    auto try_push_back(const_reference_type elem) -> pointer_type
+    {
+        return try_emplace_back(elem);
+    }
+
+    /**
+     * Insert <code>elem</code> at the end of this vector using move semantics, unless it is full.
+     * <code>elem</code> is left untouched if this vector is full.
+     * @param elem new element
+     * @returns pointer to the new element, or <code>nullptr</code> if this vector is full
+     * */
+    auto try_push_back(value_type&& elem) -> pointer_type
+    {
+        return try_emplace_back(std::move(elem));
+    }
+
+    /**
+     * Construct element in place at the end of this vector. Has no effect if this vector is full.
+     * @param args arguments to construct the new object
+     * @tparam Args types of the parameters of this function
+     * */
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> void
+    {
+        if (try_emplace_back(std::forward<Args>(args)...) == nullptr)
+            report_full();
+    }
+
+    /**
+     * Insert <code>elem</code> at the end of this vector. Has no effect if this vector is full.
+     * @param elem new element to be inserted
+     * */
+    auto push_back(const_reference_type elem) -> void
+    {
+        emplace_back(elem);
+    }
+
+    /**
+     * Insert <code>elem</code> at the end of this vector using move semantics.
+     * Has no effect if this vector is full.
+     * @param elem new element
+     * */
+    auto push_back(value_type&& elem) -> void
+    {
+        emplace_back(std::move(elem));
+    }
+
+    /**
+     * Constructs an element in place right before <code>position</code>, shifting the following
+     * ones to the right: with one memmove if they are trivially relocatable, by moves otherwise.
+     * @param position element before which the new one is placed, may be <code>end()</code>
+     * @param args arguments to construct the new object
+     * @returns iterator to the new element, or <code>end()</code> if this vector is full
+     * */
+    template <typename... Args>
+    auto emplace(const_iterator_type position, Args&&... args) -> iterator_type
+    {
+        const size_type index{ offset_of(position) };
+
+        if (full())
+        {
+            report_full();
+            return end();
+        }
+
+        pointer_type slot{ slots() + index };
+        pointer_type last{ slots() + this->m_count };
+
+        if (slot == last)
+        {
+            unchecked_emplace_back(std::forward<Args>(args)...);
+            return iterator_type{ slot };
+        }
+
+        // args may refer to an element about to be shifted
+        value_type value(std::forward<Args>(args)...);
+
+        if constexpr (is_trivially_relocatable_v<value_type>)
+        {
+            detail::move_bytes(slot + 1, slot, static_cast<size_type>(last - slot));
+
+            try
+            {
+                ::new (static_cast<void*>(slot)) value_type(std::move(value));
+            }
+            catch (...)
+            {
+                detail::move_bytes(slot, slot + 1, static_cast<size_type>(last - slot));
+                throw;
+            }
+
+            ++(this->m_count);
+        }
+        else
+        {
+            ::new (static_cast<void*>(last)) value_type(std::move(*(last - 1)));
+            ++(this->m_count);
+
+            std::move_backward(slot, last - 1, last);
+            *slot = std::move(value);
+        }
+
+        return iterator_type{ slot };
+    }
+
+    /**
+     * Inserts a copy of <code>elem</code> right before <code>position</code>.
+     * @param position element before which <code>elem</code> is placed, may be <code>end()</code>
+     * @param elem element to be inserted
+     * @returns iterator to the new element, or <code>end()</code> if this vector is full
+     * */
+    auto insert(const_iterator_type position, const_reference_type elem) -> iterator_type
+    {
+        return emplace(position, elem);
+    }
+
+    /**
+     * Moves <code>elem</code> into this vector right before <code>position</code>.
+     * @param position element before which <code>elem</code> is placed, may be <code>end()</code>
+     * @param elem element to be inserted
+     * @returns iterator to the new element, or <code>end()</code> if this vector is full
+     * */
+    auto insert(const_iterator_type position, value_type&& elem) -> iterator_type
+    {
+        return emplace(position, std::move(elem));
+    }
+
+    /**
+     * Removes the element at <code>position</code>, shifting the following ones to the left.
+     * @param position element to be removed, must be dereferenceable
+     * @returns iterator to the element that followed the removed one
+     * */
+    auto erase(const_iterator_type position) -> iterator_type
+    {
+        return erase(position, position + 1);
+    }
+
+    /**
+     * Removes the elements of [first, last), shifting the following ones to the left,
+     * with a single memmove for trivially relocatable types.
+     * @param first beginning of the range to be removed
+     * @param last end of the range to be removed
+     * @returns iterator to the element that followed the last removed one
+     * */
+    auto erase(const_iterator_type first, const_iterator_type last) -> iterator_type
+    {
+        const size_type index{ offset_of(first) };
+        const size_type end_index{ offset_of(last) };
+
+#if !defined(NDEBUG)
+        assert(index <= end_index && "Attempting to erase an invalid range...");
+#endif
+
+        pointer_type slot{ slots() + index };
+
+        if constexpr (is_trivially_relocatable_v<value_type>)
+        {
+            for (size_type gone{ index }; gone < end_index; ++gone)
+                std::destroy_at(slots() + gone);
+
+            detail::move_bytes(slot, slots() + end_index, size() - end_index);
+            this->m_count = static_cast<count_type>(size() - (end_index - index));
+        }
+        else
+        {
+            std::move(slots() + end_index, slots() + size(), slot);
+            truncate(size() - (end_index - index));
+        }
+
+        return iterator_type{ slot };
+    }
+
+    /**
+     * Removes the element at <code>position</code> in constant time by moving the last
+     * element into its slot. The order of the elements is not preserved.
+     * @param position element to be removed, must be dereferenceable
+     * @returns iterator to the element now occupying the slot of the removed one
+     * */
+    auto erase_unordered(const_iterator_type position) -> iterator_type
+    {
+        pointer_type slot{ slots() + offset_of(position) };
+        pointer_type last{ slots() + this->m_count - 1 };
+
+        if constexpr (is_trivially_relocatable_v<value_type>)
+        {
+            std::destroy_at(slot);
+
+            if (slot != last)
+                detail::move_bytes(slot, last, 1);
+        }
+        else
+        {
+            if (slot != last)
+                *slot = std::move(*last);
+
+            std::destroy_at(last);
+        }
+
+        --(this->m_count);
+
+        return iterator_type{ slot };
+    }
+
+    /**
+     * Changes the number of elements of this vector to <code>count</code>, at most <code>N</code>.
+     * Missing elements are copies of <code>value</code>, extra elements are destroyed from the end.
+     * @param count number of elements this vector must hold
+     * @param value the additional elements are copied from
+     * */
+    auto resize(size_type count, const value_type& value = value_type()) -> void
+    {
+        if (count <= size())
+            return truncate(count);
+
+        if (count > N)
+        {
+            report_full();
+            count = N;
+        }
+
+        while (size() < count)
+            unchecked_emplace_back(value);
+    }
+
+    /**
+     * Destroy the last <code>count</code> elements from this vector, or every element
+     * if there are less than <code>count</code>.
+     * @param count number of elements to be deleted
+     * */
+    auto remove_n(size_type count) -> void
+    {
+        truncate(count < size() ? size() - count : 0);
+    }
+
+    /**
+     * Remove the last element of this vector. If this vector is empty this operation has no effect.
+     * */
+    auto pop_back() -> void
+    {
+        if (this->m_count != 0)
+        {
+            std::destroy_at(slots() + this->m_count - 1);
+            --(this->m_count);
+        }
+    }
+
+    /**
+     * Remove all the elements from this vector.
+     * */
+    auto clear() -> void
+    {
+        truncate(0);
+    }
+
+    [[nodiscard]]
+    auto begin() noexcept -> iterator_type { return iterator_type{ slots() }; }
+
+    [[nodiscard]]
+    auto end() noexcept -> iterator_type { return iterator_type{ slots() + this->m_count }; }
+
+    [[nodiscard]]
+    auto begin() const noexcept -> const_iterator_type { return const_iterator_type{ slots() }; }
+
+    [[nodiscard]]
+    auto end() const noexcept -> const_iterator_type { return const_iterator_type{ slots() + this->m_count }; }
+
+    [[nodiscard]]
+    auto cbegin() const noexcept -> const_iterator_type { return begin(); }
+
+    [[nodiscard]]
+    auto cend() const noexcept -> const_iterator_type { return end(); }
+
+    /**
+     * Returns a reference to the first element of this vector.
+     * @returns front element
+     * */
+    [[nodiscard]]
+    auto front() noexcept -> reference_type
+    {
+        return (*this)[0];
+    }
+
+    /**
+     * Returns a reference to the last element of this vector.
+     * @return last element
+     * */
+    [[nodiscard]]
+    auto back() noexcept -> reference_type
+    {
+        return (*this)[size() - 1];
+    }
+
+    [[nodiscard]]
+    auto front() const noexcept -> const_reference_type
+    {
+        return (*this)[0];
+    }
+
+    [[nodiscard]]
+    auto back() const noexcept -> const_reference_type
+    {
+        return (*this)[size() - 1];
+    }
+
+private:
+    auto slots() noexcept -> pointer_type
+    {
+        return std::launder(reinterpret_cast<pointer_type>(this->m_storage));
+    }
+
+    auto slots() const noexcept -> const value_type*
+    {
+        return std::launder(reinterpret_cast<const value_type*>(this->m_storage));
+    }
+
+    template <typename... Args>
+    auto unchecked_emplace_back(Args&&... args) -> reference_type
+    {
+        pointer_type slot{ ::new (static_cast<void*>(slots() + this->m_count)) value_type(std::forward<Args>(args)...) };
+        ++(this->m_count);
+        return *slot;
+    }
+
+    auto truncate(size_type count) noexcept -> void
+    {
+        for (size_type index{ count }; index < size(); ++index)
+            std::destroy_at(slots() + index);
+
+        this->m_count = static_cast<count_type>(count);
+    }
+
+    auto offset_of(const_iterator_type position) const noexcept -> size_type
+    {
+        const auto index{ static_cast<size_type>(position.raw() - slots()) };
+
+#if !defined(NDEBUG)
+        assert(index <= size() && "Iterator does not refer to this vector...");
+#endif
+        return index;
+    }
+
+    static auto report_full() noexcept -> void
+    {
+#if !defined(NDEBUG)
+        std::printf("could not insert new element, static_vector is full...");
+#endif
+    }
+
+    /**
+     * <h3>CONSTRAINTS: N >= m_count >= 0</h3>
+     *
+     * <p><code>m_storage</code> holds the elements, the first <code>m_count</code> of them are alive</br></p>
+     * <p><code>m_count</code> is the smallest unsigned type able to count to <code>N</code></br></p>
+     * */
+
+};  // CLASS STATIC_VECTOR
+
+NAMESPACE_KT_END   // END KT NAMESPACE
+
+#endif // STATIC_VECTOR_HH
@@ -0,0 +1,219 @@
+#ifndef STATS_HH
+#define STATS_HH
+
+#include <mutex>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <typeinfo>
+
+#if defined(__GNUC__) && __has_include(<cxxabi.h>)
+    #include <cxxabi.h>
+#endif
+
+#include "common.hh"
+#include "growth.hh"
+
+NAMESPACE_KT_BEG
+
+/**
+ * Allocation and growth counters for <code>kt::vector</code>, compiled in only when
+ * <code>KT_VECTOR_STATS</code> is defined to 1 (see common.hh); otherwise the vector contains
+ * no trace of them and the reporting functions below do nothing, so instrumented code builds
+ * either way. Counters are kept per vector type, so two vectors with the same element
+ * type can be told apart by giving one of them a <code>stats::tagged</code> growth policy:
+ *
+ * <pre>
+ * struct parser_tokens;
+ * kt::vector<token, kt::allocator<token>, kt::stats::tagged<parser_tokens>> tokens{};
+ * </pre>
+ *
+ * <p>Counters are updated with relaxed atomics on reallocation and destruction only, never
+ * on element access or on appends that fit the current capacity.</p>
+ * */
+namespace stats {
+
+    using size_type = std::size_t;
+
+    /**
+     * Growth policy behaving exactly like <code>Base</code> whose only purpose is to make the
+     * vector type, and therefore its counters, distinct per <code>Tag</code>.
+     * @tparam Tag any type, usually an incomplete struct named after the call site
+     * @tparam Base policy deciding the growth
+     * */
+    template <typename Tag, typename Base = growth::doubling>
+    struct tagged : Base {};
+
+    /**
+     * Counters shared by every vector of one type. Trivially destructible so that it
+     * can still be read by reports running at process exit.
+     * */
+    struct counters
+    {
+        const std::type_info*   type{ nullptr };
+        counters*               next{ nullptr };
+
+        std::atomic<size_type>  reallocations{ 0 };
+        std::atomic<size_type>  bytes_moved{ 0 };
+        std::atomic<size_type>  peak_capacity{ 0 };
+        std::atomic<size_type>  destroyed{ 0 };
+        std::atomic<size_type>  capacity_at_destruction{ 0 };
+        std::atomic<size_type>  size_at_destruction{ 0 };
+
+        /**
+         * Returns the capacity to size ratio of every destroyed vector of this type taken
+         * together, <code>0</code> if none held any element.
+         * */
+        [[nodiscard]]
+        auto capacity_ratio() const noexcept -> double
+        {
+            const size_type size{ this->size_at_destruction.load(std::memory_order_relaxed) };
+            return size == 0 ? 0.0 : static_cast<double>(this->capacity_at_destruction.load(std::memory_order_relaxed)) /
+                                     static_cast<double>(size);
+        }
+    };
+
+#if KT_VECTOR_STATS
+    namespace detail {
+
+        inline auto registry() noexcept -> std::atomic<counters*>&
+        {
+            static std::atomic<counters*> head{ nullptr };
+            return head;
+        }
+
+        inline auto exit_hook() noexcept -> void (*&)()
+        {
+            static void (*hook)(){ nullptr };
+            return hook;
+        }
+
+        inline auto report_output() noexcept -> std::FILE*&
+        {
+            static std::FILE* output{ nullptr };
+            return output;
+        }
+
+    } // namespace detail
+
+    /**
+     * Returns the counters of the vector type <code>Vector</code>, registering
+     * them on first use so that reports can find them.
+     * */
+    template <typename Vector>
+    auto counters_for() noexcept -> counters&
+    {
+        static counters* const instance{ []() -> counters* {
+            static counters storage{};
+            storage.type = &typeid(Vector);
+
+            auto& head{ detail::registry() };
+            storage.next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(storage.next, &storage, std::memory_order_release, std::memory_order_relaxed)) {}
+
+            return &storage;
+        }() };
+
+        return *instance;
+    }
+
+    template <typename Vector>
+    auto record_reallocation(size_type bytes_moved, size_type new_capacity) noexcept -> void
+    {
+        auto& stats{ counters_for<Vector>() };
+
+        stats.reallocations.fetch_add(1, std::memory_order_relaxed);
+        stats.bytes_moved.fetch_add(bytes_moved, std::memory_order_relaxed);
+
+        size_type peak{ stats.peak_capacity.load(std::memory_order_relaxed) };
+        while (peak < new_capacity &&
+               !stats.peak_capacity.compare_exchange_weak(peak, new_capacity, std::memory_order_relaxed)) {}
+    }
+
+    template <typename Vector>
+    auto record_destruction(size_type capacity, size_type size) noexcept -> void
+    {
+        auto& stats{ counters_for<Vector>() };
+
+        stats.destroyed.fetch_add(1, std::memory_order_relaxed);
+        stats.capacity_at_destruction.fetch_add(capacity, std::memory_order_relaxed);
+        stats.size_at_destruction.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    /**
+     * Calls <code>visitor(name, counters)</code> for every vector type that recorded anything.
+     * <code>name</code> is the readable name of the type when the compiler can provide it.
+     * @param visitor callable taking <code>(const char*, const counters&)</code>
+     * */
+    template <typename Visitor>
+    auto visit(Visitor&& visitor) -> void
+    {
+        for (counters* entry{ detail::registry().load(std::memory_order_acquire) }; entry != nullptr; entry = entry->next)
+        {
+#if defined(__GNUC__) && __has_include(<cxxabi.h>)
+            int status{};
+            char* readable{ abi::__cxa_demangle(entry->type->name(), nullptr, nullptr, &status) };
+            visitor(status == 0 ? readable : entry->type->name(), static_cast<const counters&>(*entry));
+            std::free(readable);
+#else
+            visitor(entry->type->name(), static_cast<const counters&>(*entry));
+#endif
+        }
+    }
+
+    /**
+     * Writes the counters of every vector type to <code>output</code>, one JSON object per line.
+     * @param output stream the report is written to
+     * */
+    inline auto write_report(std::FILE* output) -> void
+    {
+        visit([output](const char* name, const counters& entry) -> void {
+            std::fprintf(output, "{\"type\": \"%s\", \"reallocations\": %zu, \"bytes_moved\": %zu, "
+                                 "\"peak_capacity\": %zu, \"destroyed\": %zu, \"capacity_ratio\": %.3f}\n",
+                         name,
+                         entry.reallocations.load(std::memory_order_relaxed),
+                         entry.bytes_moved.load(std::memory_order_relaxed),
+                         entry.peak_capacity.load(std::memory_order_relaxed),
+                         entry.destroyed.load(std::memory_order_relaxed),
+                         entry.capacity_ratio());
+        });
+    }
+
+    /**
+     * Arranges for a report to be produced at process exit, either by <code>hook</code> (which
+     * can use <code>visit()</code> to export the counters anywhere) or, without a hook, by
+     * <code>write_report(output)</code>. Only the first call has an effect. Vectors with static
+     * storage duration destroyed after the report are not accounted in it.
+     * @param hook exporter run at exit, or <code>nullptr</code> for the default report
+     * @param output stream used by the default report
+     * */
+    inline auto report_at_exit(void (*hook)() = nullptr, std::FILE* output = stderr) -> void
+    {
+        static std::once_flag registered{};
+
+        std::call_once(registered, [hook, output]() -> void {
+            detail::exit_hook() = hook;
+            detail::report_output() = output;
+
+            std::atexit([]() -> void {
+                if (detail::exit_hook() != nullptr)
+                    detail::exit_hook()();
+                else
+                    write_report(detail::report_output());
+            });
+        });
+    }
+#else
+    template <typename Visitor>
+    auto visit(Visitor&&) noexcept -> void {}
+
+    inline auto write_report(std::FILE*) noexcept -> void {}
+
+    inline auto report_at_exit(void (*)() = nullptr, std::FILE* = stderr) noexcept -> void {}
+#endif
+
+} // namespace stats
+
+NAMESPACE_KT_END
+
+#endif // STATS_HH
@@ -0,0 +1,290 @@
+#ifndef THREAD_POOL_HH
+#define THREAD_POOL_HH
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+#include "common.hh"
+#include "vector.hh"
+
+NAMESPACE_KT_BEG
+
+/**
+ * Fixed size pool of worker threads with one task queue per worker. Workers take tasks
+ * from the back of their own queue (most recently submitted, still hot in cache) and,
+ * once it runs dry, steal from the front of the other queues. Threads waiting for a
+ * group of tasks help running queued tasks, so nested parallel calls cannot deadlock.
+ * */
+class thread_pool
+{
+public:
+    using size_type = std::size_t;
+    using task_type = std::function<void()>;
+
+    /**
+     * Starts <code>thread_count</code> worker threads.
+     * @param thread_count number of workers, the number of hardware threads by default
+     * */
+    explicit
+    thread_pool(size_type thread_count = std::max(1u, std::thread::hardware_concurrency()))
+        :   m_queue_count{ std::max(size_type{ 1 }, thread_count) }
+        ,   m_queues{ std::make_unique<work_queue[]>(m_queue_count) }
+    {
+        this->m_workers.reserve(this->m_queue_count);
+
+        for (size_type index{}; index < this->m_queue_count; ++index)
+            this->m_workers.emplace_back([this, index]() -> void { work(index); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    auto operator=(const thread_pool&) -> thread_pool& = delete;
+
+    /**
+     * Lets the workers finish the queued tasks and joins them.
+     * */
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{ this->m_sleep_mutex };
+            this->m_stopping = true;
+        }
+
+        this->m_wake_up.notify_all();
+
+        for (auto& worker : this->m_workers)
+            worker.join();
+    }
+
+    /**
+     * Returns the number of worker threads of this pool.
+     * @returns amount of workers
+     * */
+    [[nodiscard]]
+    auto size() const noexcept -> size_type
+    {
+        return this->m_queue_count;
+    }
+
+    /**
+     * Queues <code>task</code> for execution. Tasks submitted from a worker go to its own
+     * queue, the rest are spread over the queues in round robin.
+     * @param task callable to be run by some worker
+     * */
+    auto submit(task_type task) -> void
+    {
+        const size_type target{ current_worker() != nullptr && current_worker()->pool == this ?
+                                current_worker()->index :
+                                this->m_next_queue.fetch_add(1, std::memory_order_relaxed) % size() };
+
+        this->m_pending.fetch_add(1, std::memory_order_release);
+
+        {
+            std::lock_guard<std::mutex> lock{ this->m_queues[target].mutex };
+            this->m_queues[target].tasks.push_back(std::move(task));
+        }
+
+        {
+            // pairs with the predicate check of the sleeping workers
+            std::lock_guard<std::mutex> lock{ this->m_sleep_mutex };
+        }
+
+        this->m_wake_up.notify_one();
+    }
+
+    /**
+     * Runs one queued task on the calling thread, if there is any.
+     * @returns <code>true</code> if a task was run
+     * */
+    auto run_pending_task() -> bool
+    {
+        const size_type home{ current_worker() != nullptr && current_worker()->pool == this ?
+                              current_worker()->index : 0 };
+
+        task_type task{};
+
+        if (!take_task(home, task))
+            return false;
+
+        task();
+        return true;
+    }
+
+    /**
+     * Returns the pool used by the parallel algorithms when none is given,
+     * created on first use with one worker per hardware thread.
+     * @returns process wide pool
+     * */
+    static auto default_pool() -> thread_pool&
+    {
+        static thread_pool pool{};
+        return pool;
+    }
+
+private:
+    struct work_queue
+    {
+        std::mutex              mutex{};
+        std::deque<task_type>   tasks{};
+    };
+
+    struct worker_identity
+    {
+        thread_pool*    pool;
+        size_type       index;
+    };
+
+    static auto current_worker() noexcept -> worker_identity*&
+    {
+        static thread_local worker_identity* identity{ nullptr };
+        return identity;
+    }
+
+    /**
+     * Pops a task from the back of the queue at <code>home</code> or steals
+     * one from the front of any other queue.
+     * */
+    auto take_task(size_type home, task_type& task) -> bool
+    {
+        if (this->m_pending.load(std::memory_order_acquire) == 0)
+            return false;
+
+        for (size_type offset{}; offset < size(); ++offset)
+        {
+            const size_type victim{ (home + offset) % size() };
+            auto& queue{ this->m_queues[victim] };
+
+            std::lock_guard<std::mutex> lock{ queue.mutex };
+
+            if (queue.tasks.empty())
+                continue;
+
+            if (offset == 0)
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+
+            this->m_pending.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        return false;
+    }
+
+    auto work(size_type index) -> void
+    {
+        worker_identity identity{ this, index };
+        current_worker() = &identity;
+
+        task_type task{};
+
+        for (;;)
+        {
+            if (take_task(index, task))
+            {
+                task();
+                task = nullptr;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{ this->m_sleep_mutex };
+            this->m_wake_up.wait(lock, [this]() -> bool {
+                return this->m_stopping || this->m_pending.load(std::memory_order_acquire) != 0;
+            });
+
+            if (this->m_stopping && this->m_pending.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+
+    size_type                       m_queue_count;
+    std::unique_ptr<work_queue[]>   m_queues;
+    vector<std::thread>             m_workers{};
+    std::atomic<size_type>          m_pending{ 0 };
+    std::atomic<size_type>          m_next_queue{ 0 };
+    std::mutex                      m_sleep_mutex{};
+    std::condition_variable         m_wake_up{};
+    bool                            m_stopping{ false };
+};
+
+/**
+ * Set of tasks submitted to a <code>thread_pool</code> that can be waited on as a whole.
+ * The first exception thrown by a task is rethrown by <code>wait()</code>.
+ * */
+class task_group
+{
+public:
+    explicit
+    task_group(thread_pool& pool) noexcept
+        :   m_pool{ pool }
+    {}
+
+    task_group(const task_group&) = delete;
+    auto operator=(const task_group&) -> task_group& = delete;
+
+    ~task_group()
+    {
+        // never leave tasks referring to this group behind
+        while (this->m_running.load(std::memory_order_acquire) != 0)
+            if (!this->m_pool.run_pending_task())
+                std::this_thread::yield();
+    }
+
+    /**
+     * Submits <code>function</code> to the pool as part of this group.
+     * @param function callable taking no arguments
+     * */
+    template <typename Function>
+    auto run(Function&& function) -> void
+    {
+        this->m_running.fetch_add(1, std::memory_order_relaxed);
+
+        this->m_pool.submit([this, function = std::forward<Function>(function)]() mutable -> void {
+            try
+            {
+                function();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{ this->m_error_mutex };
+                if (!this->m_error)
+                    this->m_error = std::current_exception();
+            }
+
+            this->m_running.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+
+    /**
+     * Blocks until every task of this group has finished, running queued tasks meanwhile.
+     * @throws the first exception thrown by a task of this group
+     * */
+    auto wait() -> void
+    {
+        while (this->m_running.load(std::memory_order_acquire) != 0)
+            if (!this->m_pool.run_pending_task())
+                std::this_thread::yield();
+
+        if (this->m_error)
+            std::rethrow_exception(std::exchange(this->m_error, nullptr));
+    }
+
+private:
+    thread_pool&                m_pool;
+    std::atomic<std::size_t>    m_running{ 0 };
+    std::mutex                  m_error_mutex{};
+    std::exception_ptr          m_error{};
+};
+
+NAMESPACE_KT_END
+
+#endif // THREAD_POOL_HH
@@ -2,16 +2,53 @@
 #define VECTOR_HH
 
 #include "common.hh"
+#include "allocator.hh"
+#include "relocate.hh"
+#include "growth.hh"
 #include "iterator.hh"
 #include "const_iterator.hh"
+#include "stats.hh"
 
 NAMESPACE_KT_BEG
 
-template <typename T>
+namespace detail {
+
+    /**
+     * Detects iterators over contiguous storage whose address can be taken with
+     * <code>to_address()</code>: raw pointers and the iterators of this library.
+     * */
+    template <typename It>
+    struct is_contiguous_iterator : std::is_pointer<It> {};
+
+    template <typename T>
+    struct is_contiguous_iterator<::iterator<T>> : std::true_type {};
+
+    template <typename T>
+    struct is_contiguous_iterator<::const_iterator<T>> : std::true_type {};
+
+    template <typename It>
+    inline constexpr bool is_contiguous_iterator_v = is_contiguous_iterator<It>::value;
+
+    template <typename It>
+    constexpr auto to_address(It it) noexcept
+    {
+        if constexpr (std::is_pointer_v<It>)
+            return it;
+        else
+            return it.raw();
+    }
+
+} // namespace detail
+
+template <typename T, typename Alloc = allocator<T>, typename Growth = growth::doubling>
 class vector
 {
+    using alloc_traits          = std::allocator_traits<Alloc>;
+
 public:
     using value_type            = T;
+    using allocator_type        = Alloc;
+    using growth_policy         = Growth;
     using size_type             = std::size_t;
     using reference_type        = T&;
     using pointer_type          = T*;
@@ -24,8 +61,17 @@ public:
      * and initial capacity of 0.
      * */
     explicit
-    vector() noexcept
-        :   m_array{ nullptr }, m_count{ 0 }, m_capacity{ 0 }
+    KT_CONSTEXPR vector() noexcept
+        :   m_array{ nullptr }, m_count{ 0 }, m_capacity{ 0 }, m_allocator{}
+    {}
+
+    /**
+     * Constructs an empty vector that will obtain its memory from <code>alloc</code>.
+     * @param alloc allocator used for every allocation of this vector
+     * */
+    explicit
+    KT_CONSTEXPR vector(const allocator_type& alloc) noexcept
+        :   m_array{ nullptr }, m_count{ 0 }, m_capacity{ 0 }, m_allocator{ alloc }
     {}
 
     /**
@@ -33,23 +79,26 @@ public:
      * the value <code>value</code>
      * @param count amount of copies to be made
      * @param value initial value for ech copy
+     * @param alloc allocator used for every allocation of this vector
      */
     explicit
-    vector(size_type count, const value_type& value = value_type())
-        :   m_array{ nullptr }, m_count{ count }, m_capacity{ count }
+    KT_CONSTEXPR vector(size_type count, const value_type& value = value_type(), const allocator_type& alloc = allocator_type())
+        :   m_array{ nullptr }, m_count{ count }, m_capacity{ rounded_capacity(count) }, m_allocator{ alloc }
     {
         if (m_count != 0) {
-            this->m_array = static_cast<pointer_type>(::operator new(sizeof(value_type) * count, std::nothrow));
+            this->m_array = allocate_block(this->m_capacity);
 
             // if we managed to allocate space, we fill the array with the provided value
             if (this->m_array != nullptr)
-                std::uninitialized_fill(this->m_array, this->m_array + m_count, value);
+                for (size_type index{}; index < m_count; ++index)
+                    alloc_traits::construct(this->m_allocator, this->m_array + index, value);
         }
         if (not this->m_array)
         {
 #if !defined(NDEBUG)
             std::printf("could not allocate block of memory...");
 #endif
+            this->m_count = 0;
             this->m_capacity = 0;
         }
     }
@@ -58,19 +107,27 @@ public:
      * Constructs and initializes this vector with the elements with in the
      * range of the <b>std::initializer_list</b>.
      * @param content range of elements to initialize this vector with
+     * @param alloc allocator used for every allocation of this vector
      * */
-    vector(std::initializer_list<value_type>&& content)
-        :   m_array{ static_cast<pointer_type>(::operator new(sizeof(value_type) * content.size(), std::nothrow)) }
-        ,   m_count{ content.size() }, m_capacity{ content.size() }
+    KT_CONSTEXPR vector(std::initializer_list<value_type>&& content, const allocator_type& alloc = allocator_type())
+        :   m_array{ nullptr }, m_count{ content.size() }, m_capacity{ rounded_capacity(content.size()) }, m_allocator{ alloc }
     {
+        this->m_array = allocate_block(this->m_capacity);
+
         if (this->m_array)
-            std::uninitialized_copy(content.begin(), content.end(), this->m_array);
-#if !defined(NDEBUG)
+        {
+            auto it{ this->m_array };
+            for (const auto& item : content)
+                alloc_traits::construct(this->m_allocator, it++, item);
+        }
         else
         {
+#if !defined(NDEBUG)
             std::printf("could not allocate block of memory...");
-        }
 #endif
+            this->m_count = 0;
+            this->m_capacity = 0;
+        }
     }
 
     /**
@@ -79,27 +136,28 @@ public:
      * to this vector.
      * @param first first elements from the range of elements to be copied
      * @param last last element from the range (not copied)
+     * @param alloc allocator used for every allocation of this vector
      * @tparam InputIterator iterator that allows to read the referenced content
      * */
-    template<typename InputIterator>
-    vector(InputIterator first, InputIterator last)
-        :   m_array{ nullptr }, m_count{}, m_capacity{}
+    template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    KT_CONSTEXPR vector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type())
+        :   m_array{ nullptr }, m_count{}, m_capacity{}, m_allocator{ alloc }
     {
-        // represents the number of bytes between first and last
-        size_type new_block_size{ sizeof(value_type) * (last - first) };
+        // represents the number of elements between first and last
+        size_type new_block_count{ static_cast<size_type>(std::distance(first, last)) };
 
-        if (new_block_size != 0)
+        if (new_block_count != 0)
         {
-            // new_block_size represents the size in bytes of the new block
-            this->m_array = static_cast<pointer_type>(::operator new(new_block_size, std::nothrow));
+            const size_type capacity{ rounded_capacity(new_block_count) };
+            this->m_array = allocate_block(capacity);
 
             if (this->m_array)
             {
-                for (auto start{ begin() }; first != last; ++first, ++start)
-                    new (start.raw()) value_type(*first);
+                for (auto start{ this->m_array }; first != last; ++first, ++start)
+                    alloc_traits::construct(this->m_allocator, start, *first);
 
-                this->m_count = new_block_size / sizeof(value_type);
-                this->m_capacity = new_block_size / sizeof(value_type);
+                this->m_count = new_block_count;
+                this->m_capacity = capacity;
             }
 #if !defined(NDEBUG)
             else
@@ -116,23 +174,25 @@ public:
      * less than <code>count</code> elements the behaviour of this method is undefined.
      * @param first starting point of the range of elements
      * @param count amount of elements to be copied
+     * @param alloc allocator used for every allocation of this vector
      * @tparam InputIterator iterator that allows to read the referenced content
      * */
-    template<typename InputIterator>
-    vector(InputIterator first, size_type count)
-        :   m_array{ nullptr }, m_count{ count }, m_capacity{ count }
+    template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    KT_CONSTEXPR vector(InputIterator first, size_type count, const allocator_type& alloc = allocator_type())
+        :   m_array{ nullptr }, m_count{}, m_capacity{}, m_allocator{ alloc }
     {
-        if (m_count != 0)
+        if (count != 0)
         {
-            this->m_array = static_cast<pointer_type>(::operator new(sizeof(value_type) * count, std::nothrow));
+            const size_type capacity{ rounded_capacity(count) };
+            this->m_array = allocate_block(capacity);
 
             if (this->m_array)
             {
-                for (auto start{ begin() }; start != end(); ++first, ++start)
-                    new (start.raw()) value_type(*first);
+                for (auto start{ this->m_array }; start != this->m_array + count; ++first, ++start)
+                    alloc_traits::construct(this->m_allocator, start, *first);
 
                 this->m_count = count;
-                this->m_capacity = count;
+                this->m_capacity = capacity;
             }
 #if !defined(NDEBUG)
             else
@@ -148,18 +208,29 @@ public:
      * Copies contents from <code>other</code> into this vector.
      * @param other copied from vector
      * */
-    vector(const vector& other)
+    KT_CONSTEXPR vector(const vector& other)
         :   m_array{ nullptr }, m_count{}, m_capacity{}
+        ,   m_allocator{ alloc_traits::select_on_container_copy_construction(other.m_allocator) }
     {
         if (other.size() != 0)
         {
-            this->m_array = static_cast<pointer_type>(::operator new(sizeof(value_type) * other.m_count, std::nothrow));
+            const size_type capacity{ rounded_capacity(other.m_count) };
+            this->m_array = allocate_block(capacity);
 
             if (this->m_array)
             {
-                std::copy(other.begin().raw(), other.end().raw(), this->m_array);
+                try
+                {
+                    copy_construct(other.m_array, other.m_count, this->m_array);
+                }
+                catch (...)
+                {
+                    deallocate_block(this->m_array, capacity);
+                    throw;
+                }
+
                 this->m_count = other.size();
-                this->m_capacity = other.capacity();
+                this->m_capacity = capacity;
             }
 #if !defined(NDEBUG)
             else
@@ -175,30 +246,81 @@ public:
      * @param other copied from vector
      * @returns <code>*this</code>
      * */
-    auto operator=(const vector& other) -> vector&
+    KT_CONSTEXPR auto operator=(const vector& other) -> vector&
     {
-        if (this != &other)
+        if (this == &other)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
         {
-            for (size_type index{}; index < m_count; ++index)
-                this->m_array[index].~value_type();
+            // the incoming allocator could not free the current buffer
+            if (!alloc_traits::is_always_equal::value && this->m_allocator != other.m_allocator)
+            {
+                destroy_elements();
+                deallocate_block(this->m_array, this->m_capacity);
 
-            ::operator delete(this->m_array);
-            this->m_array = static_cast<pointer_type>(::operator new(sizeof(value_type) * other.m_count, std::nothrow));
+                this->m_array = nullptr;
+                this->m_count = 0;
+                this->m_capacity = 0;
+            }
 
-            if (this->m_array)
+            this->m_allocator = other.m_allocator;
+        }
+
+        const size_type count{ other.m_count };
+
+        if (count > this->m_capacity)
+        {
+            // build the copy aside so that this vector is untouched if it fails
+            const size_type capacity{ rounded_capacity(count) };
+            pointer_type new_block{ allocate_block(capacity) };
+
+            if (new_block == nullptr)
             {
-                std::copy(other.m_array, other.m_array + other.m_count, this->m_array);
-                this->m_count = other.m_count;
-                this->m_capacity = other.m_capacity;
-            }
 #if !defined(NDEBUG)
+                std::printf("could not allocate block of memory...");
+#endif
+                return *this;
+            }
+
+            try
+            {
+                copy_construct(other.m_array, count, new_block);
+            }
+            catch (...)
+            {
+                deallocate_block(new_block, capacity);
+                throw;
+            }
+
+            destroy_elements();
+            deallocate_block(this->m_array, this->m_capacity);
+
+            this->m_array = new_block;
+            this->m_capacity = capacity;
+        }
+        else if constexpr (std::is_trivially_copyable_v<value_type>)
+        {
+            // the buffer is big enough, nothing to construct nor destroy
+            detail::copy_bytes(this->m_array, other.m_array, count);
+        }
+        else
+        {
+            // reuse the buffer: assign over live elements, then build or destroy the difference
+            const size_type common{ std::min(count, this->m_count) };
+            std::copy(other.m_array, other.m_array + common, this->m_array);
+
+            if (count > this->m_count)
+            {
+                copy_construct(other.m_array + common, count - common, this->m_array + common);
+            }
             else
             {
-                std::printf("could not allocate block of memory...");
+                truncate(count);
             }
-#endif
         }
 
+        this->m_count = count;
         return *this;
     }
 
@@ -207,8 +329,9 @@ public:
      * After this operation <code>other</code> is put into an invalid state.
      * @param other moved from vector
      * */
-    vector(vector&& other) noexcept
+    KT_CONSTEXPR vector(vector&& other) noexcept
         :   m_array{ other.m_array }, m_count{ other.m_count }, m_capacity{ other.m_capacity }
+        ,   m_allocator{ std::move(other.m_allocator) }
     {
         if (other.m_capacity != 0)
         {
@@ -221,20 +344,49 @@ public:
     /**
      * Moves the contents of the <code>other</code> vector into this vector.
      * After this operation <code>other</code> is put into an invalid state.
+     * If the allocators do not propagate and compare unequal the elements are
+     * moved one by one into storage obtained from this vector's allocator.
      * @param other moved from vector
      * @returns <code>*this</code>
      * */
-    auto operator=(vector&& other) noexcept -> vector&
+    KT_CONSTEXPR auto operator=(vector&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                            alloc_traits::is_always_equal::value) -> vector&
     {
         if (this != &other)
         {
-            this->m_array = other.m_array;
-            this->m_count = other.size();
-            this->m_capacity = other.capacity();
+            destroy_elements();
 
-            other.m_array = nullptr;
-            other.m_count = 0;
-            other.m_capacity = 0;
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value ||
+                          alloc_traits::is_always_equal::value)
+            {
+                deallocate_block(this->m_array, this->m_capacity);
+
+                if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+                    this->m_allocator = std::move(other.m_allocator);
+
+                steal(other);
+            }
+            else if (this->m_allocator == other.m_allocator)
+            {
+                deallocate_block(this->m_array, this->m_capacity);
+                steal(other);
+            }
+            else
+            {
+                // storage cannot change hands, move the elements over instead
+                this->m_count = 0;
+                reserve(other.m_count);
+
+                if (this->m_capacity >= other.m_count)
+                {
+                    for (size_type index{}; index < other.m_count; ++index)
+                        alloc_traits::construct(this->m_allocator, this->m_array + index, std::move(other.m_array[index]));
+
+                    this->m_count = other.m_count;
+                }
+
+                other.clear();
+            }
         }
 
         return *this;
@@ -253,13 +405,60 @@ public:
      * Calls the destructor for all the elements
      * in this vector and frees the underlying buffer of memory
      * */
-    ~vector()
+    KT_CONSTEXPR ~vector()
     {
+#if KT_VECTOR_STATS
+        if (!detail::is_constant_evaluated())
+            stats::record_destruction<vector>(this->m_capacity, this->m_count);
+#endif
         // pre clean-up
-        for (size_type index{}; index < m_count; ++index)
-            this->m_array[index].~T();
+        destroy_elements();
+        deallocate_block(this->m_array, this->m_capacity);
+    }
+
+    /**
+     * Takes ownership of <code>block</code>, a buffer of <code>capacity</code> elements obtained from
+     * an allocator equal to <code>get_allocator()</code> whose first <code>count</code> elements are
+     * constructed. The previous contents of this vector are destroyed and freed.
+     * @param block buffer to be owned by this vector, may be <code>nullptr</code> if <code>capacity</code> is 0
+     * @param count number of constructed elements at the beginning of <code>block</code>
+     * @param capacity number of elements <code>block</code> was allocated for
+     * */
+    KT_CONSTEXPR auto adopt(pointer_type block, size_type count, size_type capacity) noexcept -> void
+    {
+#if !defined(NDEBUG)
+        assert(count <= capacity && "Adopted buffer holds more elements than its capacity");
+#endif
+        destroy_elements();
+        deallocate_block(this->m_array, this->m_capacity);
 
-        ::operator delete(this->m_array);
+        this->m_array = block;
+        this->m_count = count;
+        this->m_capacity = capacity;
+    }
+
+    /**
+     * Gives up ownership of the buffer of this vector, which is left empty. The caller becomes
+     * responsible for destroying the <code>size()</code> elements and deallocating the block with
+     * the allocator of this vector and its <code>capacity()</code>, both read before releasing.
+     * @returns the buffer previously owned by this vector
+     * */
+    [[nodiscard]]
+    KT_CONSTEXPR auto release() noexcept -> pointer_type
+    {
+        this->m_count = 0;
+        this->m_capacity = 0;
+        return std::exchange(this->m_array, nullptr);
+    }
+
+    /**
+     * Returns a copy of the allocator associated with this vector.
+     * @returns allocator used by this vector
+     * */
+    [[nodiscard]]
+    KT_CONSTEXPR auto get_allocator() const noexcept -> allocator_type
+    {
+        return this->m_allocator;
     }
 
     /**
@@ -267,7 +466,7 @@ public:
      * @returns amount of elements contained within this vector
      * */
      [[nodiscard]]
-    auto size() const -> size_type
+    KT_CONSTEXPR auto size() const -> size_type
     {
         return this->m_count;
     }
@@ -277,7 +476,7 @@ public:
      * @returns capacity of this vector
      * */
     [[nodiscard]]
-    auto capacity() const -> size_type
+    KT_CONSTEXPR auto capacity() const -> size_type
     {
         return this->m_capacity;
     }
@@ -287,7 +486,7 @@ public:
      * @returns if this vector is empty or not
      * */
     [[nodiscard]]
-    auto empty() const -> bool
+    KT_CONSTEXPR auto empty() const -> bool
     {
         return size() == 0;
     }
@@ -298,7 +497,7 @@ public:
      * @returns reference to the element at the specified index
      * */
     [[nodiscard]]
-    auto operator[](size_type index) -> reference_type
+    KT_CONSTEXPR auto operator[](size_type index) -> reference_type
     {
 #if defined(NDEBUG)
         assert(index < size() && "Attempting to access out of bounds element...");
@@ -311,7 +510,7 @@ public:
      * @param index index of the element to be returned
      * @returns reference to the element at the given index
      * */
-    auto operator[](size_type index) const -> const_reference_type
+    KT_CONSTEXPR auto operator[](size_type index) const -> const_reference_type
     {
 #if !defined(NDEBUG)
         assert(index < size() && "Attempting to access out of bounds element...");
@@ -325,7 +524,7 @@ public:
      * @returns reference to the element at the given index
      * @throws std::runtime_error if this vector is empty or the index is out of bounds
      * */
-    auto at(size_type index) -> reference_type
+    KT_CONSTEXPR auto at(size_type index) -> reference_type
     {
         if (size() == 0)
             throw std::runtime_error("This vector has no elements");
@@ -342,7 +541,7 @@ public:
      * @returns constant reference to the element at the given index
      * @throws std::runtime_error if this vector is empty or the index is out of bounds
      * */
-    auto at(size_type index) const -> const_reference_type
+    KT_CONSTEXPR auto at(size_type index) const -> const_reference_type
     {
         if (size() == 0)
             throw std::runtime_error("This vector has no elements");
@@ -360,27 +559,69 @@ public:
      * the ones currently stored.
      * @param new_count how many extra elements we may want in this vector
      * */
-    auto reserve(size_type new_count) -> void
+    KT_CONSTEXPR auto reserve(size_type new_count) -> void
     {
-        // TODO: not fully implemented yet
         if (new_count > capacity())
-        {
-            this->m_capacity = new_count;
-            reallocate();
-        }
+            reallocate_to(new_count);
     }
 
     /**
-     * After this operation, this vector may have <code>count</code> elements.
-     * If count is greater than <code>size()</code> the necessary amount of elements
-     * are appended to this vector to have count elements, these are default initialized,
-     * otherwise the user can specify the object the additional elements must be copied from.
-     * If count is smaller than <code>size()</code> the required amount of elements are
-     * deleted from this vector.
+     * Changes the number of elements of this vector to <code>count</code>. Missing elements
+     * are value initialized and appended, extra elements are destroyed from the end.
+     * Capacity grows as dictated by the growth policy and never shrinks.
+     * @param count number of elements this vector must hold
      * */
-    auto resize(size_type count, const value_type& info = value_type()) -> void
+    KT_CONSTEXPR auto resize(size_type count) -> void
     {
+        resize_with(count, [this](pointer_type slot) -> void { alloc_traits::construct(this->m_allocator, slot); });
+    }
 
+    /**
+     * Changes the number of elements of this vector to <code>count</code>. Missing elements
+     * are copies of <code>value</code> appended at the end, extra elements are destroyed from the end.
+     * @param count number of elements this vector must hold
+     * @param value the additional elements are copied from
+     * */
+    KT_CONSTEXPR auto resize(size_type count, const value_type& value) -> void
+    {
+        resize_with(count, [this, &value](pointer_type slot) -> void { alloc_traits::construct(this->m_allocator, slot, value); });
+    }
+
+    /**
+     * Same as <code>resize(count)</code> except that missing elements are default initialized:
+     * trivially constructible elements (integers, floats, PODs) are left with indeterminate
+     * values instead of being zeroed. Intended for buffers that are about to be fully
+     * overwritten, e.g. by reading into <code>data()</code>.
+     * @param count number of elements this vector must hold
+     * */
+    KT_CONSTEXPR auto resize_for_overwrite(size_type count) -> void
+    {
+        // constant evaluation cannot hold indeterminate values, the elements are value initialized there
+        if (detail::is_constant_evaluated())
+            return resize(count);
+
+        if constexpr (std::is_trivially_default_constructible_v<value_type>)
+        {
+            if (count <= size())
+            {
+                truncate(count);
+                return maybe_shrink();
+            }
+
+            if (!grow_for(count - size()))
+            {
+#if !defined(NDEBUG)
+                std::printf("failed to resize. Could not allocate block of memory...");
+#endif
+                return;
+            }
+
+            this->m_count = count;
+        }
+        else
+        {
+            resize_with(count, [](pointer_type slot) -> void { ::new (static_cast<void*>(slot)) value_type; });
+        }
     }
 
     /**
@@ -391,50 +632,425 @@ public:
      * @tparam types of the parameters of this function
      * */
     template <typename... Args>
-    auto emplace_back(Args&&... args) -> void
+    KT_CONSTEXPR auto emplace_back(Args&&... args) -> void
     {
         if (size() == capacity())
             reallocate();
 
-        new(&this->m_array[this->m_count++]) value_type(std::forward<Args>(args)...);
+        alloc_traits::construct(this->m_allocator, this->m_array + this->m_count, std::forward<Args>(args)...);
+        ++(this->m_count);
     }
 
     /**
      * Concatenates the contents of this vector and <code>other</code>, i.e. inserts
-     * all the elements of <code>other</code> at the end of this vector.
+     * all the elements of <code>other</code> at the end of this vector. Capacity grows
+     * as dictated by the growth policy, so repeated appends run in amortized linear time.
      * @param other has the contents to be appended at the end of this vector
      * */
-    auto append(const vector& other) -> void
+    KT_CONSTEXPR auto append(const vector& other) -> void
     {
-        if (!other.empty())
+        // other may be this vector, take the count before growing
+        const size_type count{ other.size() };
+
+        if (count == 0)
+            return;
+
+        if (!grow_for(count))
         {
-            pointer_type new_block{ static_cast<pointer_type>
-                (::operator new(sizeof(value_type) * (size() + other.size()), std::nothrow)) };
+#if !defined(NDEBUG)
+            std::printf("failed to concatenate. Could not allocate block of memory...");
+#endif
+            return;
+        }
 
-            if (new_block != nullptr)
-            {
-                // Move this vector's memory block data to the newly allocated block
-                std::memcpy(static_cast<void*>(new_block), static_cast<const void*>(this->m_array),size() * sizeof(value_type));
+        construct_from(other.m_array, count);
+    }
+
+    /**
+     * Moves all the elements of <code>other</code> to the end of this vector, leaving
+     * <code>other</code> empty. If this vector is empty and can take ownership of the
+     * storage of <code>other</code> no element is touched, trivially relocatable elements are
+     * memcpy'd and the rest are move constructed.
+     * @param other has the contents to be appended at the end of this vector
+     * */
+    KT_CONSTEXPR auto append(vector&& other) -> void
+    {
+        if (this == &other || other.empty())
+            return;
+
+        if (this->m_count == 0 && (alloc_traits::is_always_equal::value || this->m_allocator == other.m_allocator))
+        {
+            deallocate_block(this->m_array, this->m_capacity);
+            steal(other);
+            return;
+        }
+
+        if (!grow_for(other.m_count))
+        {
+#if !defined(NDEBUG)
+            std::printf("failed to concatenate. Could not allocate block of memory...");
+#endif
+            return;
+        }
+
+        // leaves the source elements destroyed, or untouched if a copy throws
+        detail::relocate(this->m_allocator, other.m_array, other.m_count, this->m_array + this->m_count);
+
+        this->m_count += other.m_count;
+        other.m_count = 0;
+    }
+
+    /**
+     * Inserts copies of the elements of [first, last) at the end of this vector. Storage is
+     * allocated once when the length of the range is known up front (forward iterators), and
+     * ranges of contiguous trivially copyable elements are copied with a single memcpy.
+     * The range must not refer to elements of this vector.
+     * @param first beginning of the range
+     * @param last end of the range
+     * @tparam InputIterator type of the iterators of the range
+     * */
+    template <typename InputIterator>
+    KT_CONSTEXPR auto append_range(InputIterator first, InputIterator last) -> void
+    {
+        if constexpr (detail::is_contiguous_iterator_v<InputIterator>)
+        {
+            const auto source{ detail::to_address(first) };
+            append_counted(source, static_cast<size_type>(detail::to_address(last) - source));
+        }
+        else if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                             typename std::iterator_traits<InputIterator>::iterator_category>)
+        {
+            append_counted(first, static_cast<size_type>(std::distance(first, last)));
+        }
+        else
+        {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+    }
+
+    /**
+     * Constructs an element in place right before <code>position</code>. The elements after it
+     * are shifted one slot to the right: trivially relocatable ones with a single memmove, the
+     * rest by move construction and move assignment. <code>args</code> may refer to elements of
+     * this vector.
+     * @param position element before which the new one is placed, may be <code>end()</code>
+     * @param args arguments to construct the new object
+     * @returns iterator to the new element, or <code>end()</code> if storage could not be allocated
+     * */
+    template <typename... Args>
+    KT_CONSTEXPR auto emplace(const_iterator_type position, Args&&... args) -> iterator_type
+    {
+        const size_type index{ offset_of(position) };
 
-                // Copy the contents of other at the end of this vector
-                auto it{ new_block + size() };
-                for (const auto& item : other)
-                    new (it++) value_type(item);
+        if (index == this->m_count && this->m_count < this->m_capacity)
+        {
+            alloc_traits::construct(this->m_allocator, this->m_array + index, std::forward<Args>(args)...);
+            ++(this->m_count);
+            return iterator_type{ this->m_array + index };
+        }
 
-                ::operator delete(static_cast<void*>(this->m_array));
+        // built before growing or shifting, either of which could move what args refer to
+        value_type value(std::forward<Args>(args)...);
 
-                this->m_array = new_block;
-                this->m_count = this->m_count + other.m_count;
-                this->m_capacity = this->m_count;
+        if (!grow_for(1))
+        {
+#if !defined(NDEBUG)
+            std::printf("could not insert new element. Could not allocate block of memory...");
+#endif
+            return end();
+        }
 
+        if constexpr (is_trivially_relocatable_v<value_type>)
+        {
+            return insert_with(index, 1, [this, &value](pointer_type slot) -> void {
+                alloc_traits::construct(this->m_allocator, slot, std::move(value));
+            });
+        }
+        else
+        {
+            pointer_type slot{ this->m_array + index };
+            pointer_type last{ this->m_array + this->m_count };
+
+            if (slot == last)
+            {
+                alloc_traits::construct(this->m_allocator, slot, std::move(value));
+                ++(this->m_count);
             }
             else
             {
+                alloc_traits::construct(this->m_allocator, last, std::move(*(last - 1)));
+                ++(this->m_count);
+
+                std::move_backward(slot, last - 1, last);
+                *slot = std::move(value);
+            }
+
+            return iterator_type{ slot };
+        }
+    }
+
+    /**
+     * Inserts a copy of <code>elem</code> right before <code>position</code>.
+     * @param position element before which <code>elem</code> is placed, may be <code>end()</code>
+     * @param elem element to be inserted
+     * @returns iterator to the new element, or <code>end()</code> if storage could not be allocated
+     * */
+    KT_CONSTEXPR auto insert(const_iterator_type position, const_reference_type elem) -> iterator_type
+    {
+        return emplace(position, elem);
+    }
+
+    /**
+     * Moves <code>elem</code> into this vector right before <code>position</code>.
+     * @param position element before which <code>elem</code> is placed, may be <code>end()</code>
+     * @param elem element to be inserted
+     * @returns iterator to the new element, or <code>end()</code> if storage could not be allocated
+     * */
+    KT_CONSTEXPR auto insert(const_iterator_type position, value_type&& elem) -> iterator_type
+    {
+        return emplace(position, std::move(elem));
+    }
+
+    /**
+     * Inserts <code>count</code> copies of <code>elem</code> right before <code>position</code>.
+     * @param position element before which the copies are placed, may be <code>end()</code>
+     * @param count number of copies
+     * @param elem value of the copies, may be an element of this vector
+     * @returns iterator to the first copy, or <code>end()</code> if storage could not be allocated
+     * */
+    KT_CONSTEXPR auto insert(const_iterator_type position, size_type count, const_reference_type elem) -> iterator_type
+    {
+        const size_type index{ offset_of(position) };
+
+        if (count == 0)
+            return iterator_type{ this->m_array + index };
+
+        const value_type value(elem);
+
+        if (!grow_for(count))
+        {
+#if !defined(NDEBUG)
+            std::printf("could not insert new elements. Could not allocate block of memory...");
+#endif
+            return end();
+        }
+
+        return insert_with(index, count, [this, &value](pointer_type slot) -> void {
+            alloc_traits::construct(this->m_allocator, slot, value);
+        });
+    }
+
+    /**
+     * Inserts copies of the elements of [first, last) right before <code>position</code>,
+     * allocating once when the length of the range is known up front. The range must not
+     * refer to elements of this vector.
+     * @param position element before which the range is placed, may be <code>end()</code>
+     * @param first beginning of the range
+     * @param last end of the range
+     * @returns iterator to the first inserted element, or <code>end()</code> if storage could not be allocated
+     * @tparam InputIterator type of the iterators of the range
+     * */
+    template <typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    KT_CONSTEXPR auto insert(const_iterator_type position, InputIterator first, InputIterator last) -> iterator_type
+    {
+        const size_type index{ offset_of(position) };
+
+        if constexpr (detail::is_contiguous_iterator_v<InputIterator> ||
+                      std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<InputIterator>::iterator_category>)
+        {
+            const auto count{ static_cast<size_type>(std::distance(first, last)) };
+
+            if (count == 0)
+                return iterator_type{ this->m_array + index };
+
+            if (!grow_for(count))
+            {
+#if !defined(NDEBUG)
+                std::printf("could not insert range. Could not allocate block of memory...");
+#endif
+                return end();
+            }
+
+            return insert_with(index, count, [this, &first](pointer_type slot) -> void {
+                alloc_traits::construct(this->m_allocator, slot, *first);
+                ++first;
+            });
+        }
+        else
+        {
+            // the length is unknown, append then rotate the new elements into place
+            const size_type old_count{ this->m_count };
+
+            append_range(first, last);
+            std::rotate(this->m_array + index, this->m_array + old_count, this->m_array + this->m_count);
+
+            return iterator_type{ this->m_array + index };
+        }
+    }
+
+    /**
+     * Inserts copies of the elements of <code>content</code> right before <code>position</code>.
+     * @param position element before which the elements are placed, may be <code>end()</code>
+     * @param content elements to be inserted
+     * @returns iterator to the first inserted element, or <code>end()</code> if storage could not be allocated
+     * */
+    KT_CONSTEXPR auto insert(const_iterator_type position, std::initializer_list<value_type> content) -> iterator_type
+    {
+        return insert(position, content.begin(), content.end());
+    }
+
+    /**
+     * Removes the element at <code>position</code>, shifting the following ones one slot to
+     * the left, with a single memmove for trivially relocatable types.
+     * @param position element to be removed, must be dereferenceable
+     * @returns iterator to the element that followed the removed one
+     * */
+    KT_CONSTEXPR auto erase(const_iterator_type position) -> iterator_type
+    {
+        return erase(position, position + 1);
+    }
+
+    /**
+     * Removes the elements of [first, last), shifting the following ones to the left,
+     * with a single memmove for trivially relocatable types.
+     * @param first beginning of the range to be removed
+     * @param last end of the range to be removed
+     * @returns iterator to the element that followed the last removed one
+     * */
+    KT_CONSTEXPR auto erase(const_iterator_type first, const_iterator_type last) -> iterator_type
+    {
+        const size_type index{ offset_of(first) };
+        const size_type end_index{ offset_of(last) };
+
+#if !defined(NDEBUG)
+        assert(index <= end_index && "Attempting to erase an invalid range...");
+#endif
+
+        if (index == end_index)
+            return iterator_type{ this->m_array + index };
+
+        const size_type count{ end_index - index };
+
+        if constexpr (is_trivially_relocatable_v<value_type>)
+        {
+            for (size_type gone{ index }; gone < end_index; ++gone)
+                alloc_traits::destroy(this->m_allocator, this->m_array + gone);
+
+            detail::move_bytes(this->m_array + index, this->m_array + end_index, this->m_count - end_index);
+
+            this->m_count -= count;
+        }
+        else
+        {
+            std::move(this->m_array + end_index, this->m_array + this->m_count, this->m_array + index);
+            truncate(this->m_count - count);
+        }
+
+        maybe_shrink();
+        return iterator_type{ this->m_array + index };
+    }
+
+    /**
+     * Removes the element at <code>position</code> in constant time by moving the last
+     * element into its slot. The order of the elements is not preserved.
+     * @param position element to be removed, must be dereferenceable
+     * @returns iterator to the element now occupying the slot of the removed one
+     * */
+    KT_CONSTEXPR auto erase_unordered(const_iterator_type position) -> iterator_type
+    {
+        const size_type index{ offset_of(position) };
+
 #if !defined(NDEBUG)
-                std::printf("failed to concatenate. Could not allocate block of memory...");
+        assert(index < size() && "Attempting to erase out of bounds element...");
 #endif
+
+        pointer_type slot{ this->m_array + index };
+        pointer_type last{ this->m_array + this->m_count - 1 };
+
+        if constexpr (is_trivially_relocatable_v<value_type>)
+        {
+            alloc_traits::destroy(this->m_allocator, slot);
+
+            if (slot != last)
+                detail::move_bytes(slot, last, 1);
+        }
+        else
+        {
+            if (slot != last)
+                *slot = std::move(*last);
+
+            alloc_traits::destroy(this->m_allocator, last);
+        }
+
+        --(this->m_count);
+        maybe_shrink();
+        return iterator_type{ this->m_array + index };
+    }
+
+    /**
+     * Removes every element for which <code>pred</code> returns <code>true</code>, keeping the
+     * order of the rest, in a single pass that calls <code>pred</code> once per element. Runs of
+     * trivially relocatable survivors are moved down with one memmove each, other types are move
+     * assigned. If <code>pred</code> throws every element not yet visited is kept, next to moved
+     * from ones for types that are not trivially relocatable.
+     * @param pred unary predicate taking a <code>const value_type&</code>
+     * @returns number of removed elements
+     * @tparam Predicate type of the predicate
+     * */
+    template <typename Predicate>
+    KT_CONSTEXPR auto erase_if(Predicate pred) -> size_type
+    {
+        pointer_type last{ this->m_array + this->m_count };
+        pointer_type write{ std::find_if(this->m_array, last, [&pred](const_reference_type elem) -> bool { return pred(elem); }) };
+
+        if (write == last)
+            return 0;
+
+        if constexpr (is_trivially_relocatable_v<value_type>)
+        {
+            // write is the first free slot, [run, read) the survivors not yet moved down to it
+            pointer_type read{ write };
+            pointer_type run{ write };
+
+            try
+            {
+                // read always points to an element to be removed here
+                while (read != last)
+                {
+                    alloc_traits::destroy(this->m_allocator, read);
+                    run = ++read;
+
+                    while (read != last && !pred(static_cast<const_reference_type>(*read)))
+                        ++read;
+
+                    detail::move_bytes(write, run, static_cast<size_type>(read - run));
+                    write += read - run;
+                    run = read;
+                }
             }
+            catch (...)
+            {
+                detail::move_bytes(write, run, static_cast<size_type>(last - run));
+                this->m_count = static_cast<size_type>(write - this->m_array) + static_cast<size_type>(last - run);
+                throw;
+            }
+
+            this->m_count = static_cast<size_type>(write - this->m_array);
+        }
+        else
+        {
+            for (pointer_type read{ write + 1 }; read != last; ++read)
+                if (!pred(static_cast<const_reference_type>(*read)))
+                    *write++ = std::move(*read);
+
+            truncate(static_cast<size_type>(write - this->m_array));
         }
+
+        const size_type removed{ static_cast<size_type>(last - write) };
+        maybe_shrink();
+        return removed;
     }
 
     /**
@@ -443,16 +1059,13 @@ public:
      * the effects of this function are the same as <code>clear()</code>.
      * @param count number of elements to be deleted
      * */
-    auto remove_n(size_type count) -> void
+    KT_CONSTEXPR auto remove_n(size_type count) -> void
     {
         if (count < size())
         {
-            // if we have more than count elements
-            std::for_each(begin(),
-                          end(),
-                          [](reference_type info) -> void { info.~value_type(); });
-
-            this->m_count = size() - count;
+            // only the last count elements go, the rest stay untouched
+            truncate(size() - count);
+            maybe_shrink();
         }
         else
         {
@@ -464,11 +1077,11 @@ public:
      * Insert <code>elem</code> at the end of this vector.
      * @param elem new element to be inserted
      * */
-    auto push_back(const_reference_type elem) -> void
+    KT_CONSTEXPR auto push_back(const_reference_type elem) -> void
     {
         if (capacity() > size())
         {
-            new(&this->m_array[this->m_count]) value_type(elem);
+            alloc_traits::construct(this->m_allocator, this->m_array + this->m_count, elem);
             this->m_count += 1;
         }
         else
@@ -485,7 +1098,7 @@ public:
                 return;
             }
 
-            new(&this->m_array[this->m_count]) value_type(elem);
+            alloc_traits::construct(this->m_allocator, this->m_array + this->m_count, elem);
             this->m_count += 1;
         }
     }
@@ -495,11 +1108,11 @@ public:
      * using move semantics.
      * @param elem new element
      * */
-    auto push_back(value_type&& elem) -> void
+    KT_CONSTEXPR auto push_back(value_type&& elem) -> void
     {
         if (capacity() > size())
         {
-            new(&this->m_array[this->m_count]) value_type(std::move(elem));
+            alloc_traits::construct(this->m_allocator, this->m_array + this->m_count, std::move(elem));
             this->m_count += 1;
         }
         else
@@ -516,7 +1129,7 @@ public:
                 return;
             }
 
-            new(&this->m_array[this->m_count]) value_type(std::move(elem));
+            alloc_traits::construct(this->m_allocator, this->m_array + this->m_count, std::move(elem));
             ++(this->m_count);
         }
     }
@@ -524,24 +1137,40 @@ public:
     /**
      * Remove the last element of this vector. If this vector is empty this operation has no effect.
      * */
-    auto pop_back() -> void
+    KT_CONSTEXPR auto pop_back() -> void
     {
         if (this->m_count != 0)
         {
-            (*this)[size() - 1].~value_type();
+            alloc_traits::destroy(this->m_allocator, this->m_array + this->m_count - 1);
             --(this->m_count);
+            maybe_shrink();
         }
     }
 
     /**
-     * Remove all the elements from this vector
+     * Remove all the elements from this vector. The buffer is kept unless the growth policy
+     * shrinks; large mapped buffers give their pages back to the system meanwhile.
      * */
-    auto clear() -> void
+    KT_CONSTEXPR auto clear() -> void
     {
-        std::for_each(begin(),
-                      end(),
-                      [](reference_type info) -> void { info.~value_type(); });
+        destroy_elements();
         this->m_count = 0;
+
+        if constexpr (detail::has_discard_v<allocator_type>)
+            if (this->m_array != nullptr && !detail::is_constant_evaluated())
+                this->m_allocator.discard(this->m_array, this->m_capacity);
+
+        maybe_shrink();
+    }
+
+    /**
+     * Reduces the capacity of this vector to its size, freeing the buffer if it is empty.
+     * The growth policy may round the capacity up. On failure the vector keeps its buffer.
+     * */
+    KT_CONSTEXPR auto shrink_to_fit() -> void
+    {
+        if (this->m_count < this->m_capacity)
+            shrink_to(this->m_count);
     }
 
     /**
@@ -609,7 +1238,7 @@ public:
      * @returns front element
      * */
     [[nodiscard]]
-    auto front() noexcept -> reference_type
+    KT_CONSTEXPR auto front() noexcept -> reference_type
     {
         return *this->m_array;
     }
@@ -618,7 +1247,7 @@ public:
      * Returns a reference to the last element of this vector.
      * @return last element
      * */
-    auto back() noexcept -> reference_type 
+    KT_CONSTEXPR auto back() noexcept -> reference_type 
     {
 #if !defined(NDEBUG)
         assert(!empty() && "Attempting to retrieve back element of empty vector");
@@ -630,7 +1259,7 @@ public:
      * Returns a constant reference to the first element of this vector.
      * @return front element
      * */
-    auto front() const noexcept -> const_reference_type 
+    KT_CONSTEXPR auto front() const noexcept -> const_reference_type 
     {
 #if !defined(NDEBUG)
         assert(!empty() && "Attempting to retrieve front element of empty vector");
@@ -642,7 +1271,7 @@ public:
      * Returns a constant reference to the last element of this vector.
      * @returns last element
      * */
-    auto back() const noexcept -> const_reference_type 
+    KT_CONSTEXPR auto back() const noexcept -> const_reference_type 
     {
 #if !defined(NDEBUG)
         assert(!empty() && "Attempting to retrieve back element of empty vector");
@@ -651,35 +1280,381 @@ public:
     }
 
 private:
-    static constexpr size_type GROW_FACTOR{ 2 };
+    KT_CONSTEXPR auto reallocate() -> void
+    {
+        // the growth policy decides the capacity, starting from an empty vector included
+        reallocate_to(growth_policy::next_capacity(this->m_capacity, this->m_count + 1, sizeof(value_type)));
+    }
 
-    auto reallocate() -> void
+    /**
+     * Moves the elements of this vector to a block able to hold <code>new_block_count</code>
+     * elements. How the elements travel is decided at compile time (see <code>detail::relocation</code>):
+     * the block is resized in place through the allocator when possible, trivially relocatable
+     * elements are memcpy'd and everything else is moved element by element.
+     * On failure this vector is left untouched.
+     * @param new_block_count capacity of the new block, must not be smaller than <code>size()</code>.
+     * The growth policy may round it up
+     * @returns <code>true</code> if this vector now has at least the requested capacity
+     * */
+    KT_CONSTEXPR auto reallocate_to(size_type new_block_count) -> bool
     {
-        // we reserve space for one element if the vector is empty when reallocate() is called
-        size_type new_block_count{ (this->m_capacity == 0) ? 1 : (this->m_capacity * GROW_FACTOR) };
-        pointer_type new_block{ static_cast<pointer_type>(::operator new(sizeof(T) * new_block_count, std::nothrow)) };
+        pointer_type new_block{ nullptr };
+        new_block_count = growth_policy::round_capacity(new_block_count, sizeof(value_type));
+
+        if constexpr (detail::relocation_for<value_type, allocator_type> == detail::relocation::realloc)
+        {
+            // there is no realloc() during constant evaluation, the block is moved instead
+            if (detail::is_constant_evaluated())
+                new_block = relocate_to_new_block(new_block_count);
+            else
+                new_block = this->m_array != nullptr ?
+                    this->m_allocator.reallocate(this->m_array, this->m_capacity, new_block_count) :
+                    allocate_block(new_block_count);
+        }
+        else
+        {
+            new_block = relocate_to_new_block(new_block_count);
+        }
 
         if (new_block == nullptr)
         {
 #if !defined(NDEBUG)
             std::printf("Failed to allocate new block of memory");
 #endif
-            return;
+            return false;
         }
 
-        // we just want to move the contents from one block of memory to another
-        std::memcpy(static_cast<void*>(new_block), static_cast<const void*>(this->m_array),
-            this->m_count * sizeof(value_type));
-
-        ::operator delete(static_cast<void*>(this->m_array));
+        if constexpr (growth_policy::use_usable_size && detail::has_usable_size_v<allocator_type>)
+            if (!detail::is_constant_evaluated())
+                new_block_count = this->m_allocator.usable_size(new_block, new_block_count);
 
+#if KT_VECTOR_STATS
+        if (!detail::is_constant_evaluated())
+            stats::record_reallocation<vector>(this->m_count * sizeof(value_type), new_block_count);
+#endif
         this->m_array = new_block;
         this->m_capacity = new_block_count;
+
+        return true;
+    }
+
+    /**
+     * Allocates a block of <code>count</code> elements and relocates the elements of this vector
+     * into it, freeing the current block.
+     * @returns the new block, or <code>nullptr</code> if the allocation failed and nothing changed
+     * */
+    KT_CONSTEXPR auto relocate_to_new_block(size_type count) -> pointer_type
+    {
+        pointer_type new_block{ allocate_block(count) };
+
+        if (new_block != nullptr)
+        {
+            try
+            {
+                detail::relocate(this->m_allocator, this->m_array, this->m_count, new_block);
+            }
+            catch (...)
+            {
+                deallocate_block(new_block, count);
+                throw;
+            }
+
+            deallocate_block(this->m_array, this->m_capacity);
+        }
+
+        return new_block;
+    }
+
+    /**
+     * Returns the capacity the growth policy asks for when exactly <code>count</code> elements
+     * must fit, e.g. when building a vector of a known size.
+     * */
+    static constexpr auto rounded_capacity(size_type count) noexcept -> size_type
+    {
+        return count != 0 ? growth_policy::round_capacity(count, sizeof(value_type)) : 0;
+    }
+
+    /**
+     * Requests storage for <code>count</code> elements from the allocator of this vector.
+     * @returns pointer to the new block or <code>nullptr</code> if the allocation failed
+     * */
+    KT_CONSTEXPR auto allocate_block(size_type count) -> pointer_type
+    {
+        return count != 0 ? alloc_traits::allocate(this->m_allocator, count) : nullptr;
+    }
+
+    /**
+     * Gives back a block previously obtained through <code>allocate_block()</code>.
+     * */
+    KT_CONSTEXPR auto deallocate_block(pointer_type block, size_type count) noexcept -> void
+    {
+        if (block != nullptr)
+            alloc_traits::deallocate(this->m_allocator, block, count);
+    }
+
+    /**
+     * Lets a shrinking growth policy reduce the capacity after elements were removed.
+     * */
+    KT_CONSTEXPR auto maybe_shrink() -> void
+    {
+        if constexpr (growth_policy::shrinks)
+        {
+            const size_type target{ growth_policy::shrink_capacity(this->m_capacity, this->m_count, sizeof(value_type)) };
+
+            if (target < this->m_capacity)
+                shrink_to(std::max(target, this->m_count));
+        }
+    }
+
+    KT_CONSTEXPR auto shrink_to(size_type new_capacity) -> void
+    {
+        if (new_capacity == 0)
+        {
+            deallocate_block(this->m_array, this->m_capacity);
+            this->m_array = nullptr;
+            this->m_capacity = 0;
+            return;
+        }
+
+        reallocate_to(new_capacity);
+    }
+
+    /**
+     * Destroys the elements past the first <code>count</code> ones.
+     * */
+    KT_CONSTEXPR auto truncate(size_type count) noexcept -> void
+    {
+        for (size_type index{ count }; index < this->m_count; ++index)
+            alloc_traits::destroy(this->m_allocator, this->m_array + index);
+
+        this->m_count = count;
+    }
+
+    KT_CONSTEXPR auto destroy_elements() noexcept -> void
+    {
+        for (size_type index{}; index < this->m_count; ++index)
+            alloc_traits::destroy(this->m_allocator, this->m_array + index);
+    }
+
+    /**
+     * Makes room for <code>extra</code> more elements, growing as the growth policy dictates
+     * but never less than needed.
+     * @returns <code>true</code> if <code>extra</code> elements can be added without reallocating
+     * */
+    KT_CONSTEXPR auto grow_for(size_type extra) -> bool
+    {
+        const size_type required{ this->m_count + extra };
+
+        if (required <= this->m_capacity)
+            return true;
+
+        return reallocate_to(std::max(required, growth_policy::next_capacity(this->m_capacity, required, sizeof(value_type))));
+    }
+
+    /**
+     * Shrinks this vector to <code>count</code> elements or grows it, building every
+     * new element with <code>construct(slot)</code>. If a construction throws the
+     * elements added so far are destroyed and the size is left unchanged.
+     * */
+    template <typename Construct>
+    KT_CONSTEXPR auto resize_with(size_type count, Construct construct) -> void
+    {
+        if (count <= size())
+        {
+            truncate(count);
+            return maybe_shrink();
+        }
+
+        if (!grow_for(count - size()))
+        {
+#if !defined(NDEBUG)
+            std::printf("failed to resize. Could not allocate block of memory...");
+#endif
+            return;
+        }
+
+        size_type index{ this->m_count };
+
+        try
+        {
+            for (; index < count; ++index)
+                construct(this->m_array + index);
+        }
+        catch (...)
+        {
+            for (size_type built{ this->m_count }; built < index; ++built)
+                alloc_traits::destroy(this->m_allocator, this->m_array + built);
+            throw;
+        }
+
+        this->m_count = count;
     }
-    
+
+    KT_CONSTEXPR auto offset_of(const_iterator_type position) const noexcept -> size_type
+    {
+        const auto index{ static_cast<size_type>(position.raw() - this->m_array) };
+
+#if !defined(NDEBUG)
+        assert(index <= size() && "Iterator does not refer to this vector...");
+#endif
+        return index;
+    }
+
+    /**
+     * Opens a hole of <code>count</code> slots at <code>index</code>, which must fit the current
+     * capacity, and builds the new elements in order with <code>construct(slot)</code>. Trivially
+     * relocatable elements are moved out of the way with one memmove; any other type is built at
+     * the end and rotated into place. If a construction throws the vector is left as it was.
+     * @returns iterator to the first new element
+     * */
+    template <typename Construct>
+    KT_CONSTEXPR auto insert_with(size_type index, size_type count, Construct construct) -> iterator_type
+    {
+        pointer_type slot{ this->m_array + index };
+        const size_type tail{ this->m_count - index };
+
+        if constexpr (is_trivially_relocatable_v<value_type>)
+        {
+            detail::move_bytes(slot + count, slot, tail);
+
+            size_type built{};
+
+            try
+            {
+                for (; built < count; ++built)
+                    construct(slot + built);
+            }
+            catch (...)
+            {
+                for (size_type gone{}; gone < built; ++gone)
+                    alloc_traits::destroy(this->m_allocator, slot + gone);
+
+                detail::move_bytes(slot, slot + count, tail);
+                throw;
+            }
+
+            this->m_count += count;
+        }
+        else
+        {
+            const size_type old_count{ this->m_count };
+
+            try
+            {
+                for (size_type built{}; built < count; ++built)
+                {
+                    construct(this->m_array + this->m_count);
+                    ++(this->m_count);
+                }
+            }
+            catch (...)
+            {
+                truncate(old_count);
+                throw;
+            }
+
+            std::rotate(slot, this->m_array + old_count, this->m_array + this->m_count);
+        }
+
+        return iterator_type{ slot };
+    }
+
+    template <typename Source>
+    KT_CONSTEXPR auto append_counted(Source source, size_type count) -> void
+    {
+        if (count == 0)
+            return;
+
+        if (!grow_for(count))
+        {
+#if !defined(NDEBUG)
+            std::printf("failed to append range. Could not allocate block of memory...");
+#endif
+            return;
+        }
+
+        construct_from(source, count);
+    }
+
+    /**
+     * Copy constructs <code>count</code> elements read from <code>source</code> past the last
+     * element of this vector, which must have room for them. Either all of them are appended
+     * or, if a copy throws, none.
+     * */
+    template <typename Source>
+    KT_CONSTEXPR auto construct_from(Source source, size_type count) -> void
+    {
+        pointer_type destination{ this->m_array + this->m_count };
+
+        if constexpr (std::is_pointer_v<Source> && std::is_trivially_copyable_v<value_type> &&
+                      std::is_same_v<std::remove_cv_t<std::remove_pointer_t<Source>>, value_type>)
+        {
+            detail::copy_bytes(destination, static_cast<const value_type*>(source), count);
+        }
+        else
+        {
+            size_type built{};
+
+            try
+            {
+                for (; built < count; ++built, ++source)
+                    alloc_traits::construct(this->m_allocator, destination + built, *source);
+            }
+            catch (...)
+            {
+                for (size_type index{}; index < built; ++index)
+                    alloc_traits::destroy(this->m_allocator, destination + index);
+                throw;
+            }
+        }
+
+        this->m_count += count;
+    }
+
+    /**
+     * Copy constructs <code>count</code> elements from <code>source</code> into the raw storage at
+     * <code>destination</code>, with a single memcpy for trivially copyable types. If a copy throws
+     * the elements built so far are destroyed.
+     * */
+    KT_CONSTEXPR auto copy_construct(const value_type* source, size_type count, pointer_type destination) -> void
+    {
+        if constexpr (std::is_trivially_copyable_v<value_type>)
+        {
+            detail::copy_bytes(destination, source, count);
+        }
+        else
+        {
+            size_type built{};
+
+            try
+            {
+                for (; built < count; ++built)
+                    alloc_traits::construct(this->m_allocator, destination + built, source[built]);
+            }
+            catch (...)
+            {
+                for (size_type index{}; index < built; ++index)
+                    alloc_traits::destroy(this->m_allocator, destination + index);
+                throw;
+            }
+        }
+    }
+
+    KT_CONSTEXPR auto steal(vector& other) noexcept -> void
+    {
+        this->m_array = other.m_array;
+        this->m_count = other.m_count;
+        this->m_capacity = other.m_capacity;
+
+        other.m_array = nullptr;
+        other.m_count = 0;
+        other.m_capacity = 0;
+    }
+
     pointer_type    m_array;
     size_type       m_count;
     size_type       m_capacity;
+    allocator_type  m_allocator;
 
     /**
      * <h3>CONSTRAINTS: m_capacity >= m_count >= 0</h3>
@@ -688,13 +1663,23 @@ private:
      * <p><code>value_type</code> must support the operations of <strong>copy assignment/copy construction or move assigment/move construction</strong></p>
      *
      * <p><code>m_array</code> points to the underlying memory buffer owned by this vector or its value is nullptr</br></p>
-     * <p><code>m_capacity</code> is increased by a growth factor to minimise the number of call to reallocate()</br></p>
+     * <p><code>m_capacity</code> is increased as dictated by <code>Growth</code> to minimise the number of call to reallocate()</br></p>
      * <p><code>m_count</code> keeps track of the amount of valid elements in this vector inside the vector</br></p>
+     * <p><code>m_allocator</code> provides every block of memory this vector owns, blocks are given back to it with their capacity</br></p>
      * */
 
 
 };  // CLASS VECTOR
 
+/**
+ * Vector whose buffer starts at an <code>Alignment</code> boundary and whose capacity always
+ * covers a whole number of <code>Alignment</code> sized chunks.
+ * @tparam T type of the elements
+ * @tparam Alignment alignment and padding granularity in bytes, defaults to a cache line
+ * */
+template <typename T, std::size_t Alignment = cache_line_size>
+using aligned_vector = vector<T, aligned_allocator<T, Alignment>, growth::padded<Alignment>>;
+
 NAMESPACE_KT_END   // END KT NAMESPACE
 
 #endif
@@ -0,0 +1,50 @@
+#include <string>
+#include <cstdint>
+#include <iostream>
+#include <vector.hh>
+
+// one AVX-512 register worth of floats, itself over-aligned
+struct alignas(64) lane_block
+{
+    float lanes[16];
+};
+
+template <typename T>
+auto offset_in_line(const T* address) -> std::uintptr_t
+{
+    return reinterpret_cast<std::uintptr_t>(address) % kt::cache_line_size;
+}
+
+int main(int, char**) {
+    // the buffer starts on a cache line and the capacity covers whole 64 byte chunks
+    kt::aligned_vector<float> samples{};
+    for (int index{}; index < 37; ++index)
+        samples.push_back(0.25f * static_cast<float>(index));
+
+    std::cout << "floats: size " << samples.size() << ", capacity " << samples.capacity()
+              << " (" << samples.capacity() * sizeof(float) << " bytes), offset in line "
+              << offset_in_line(samples.data()) << std::endl;
+
+    // 32 byte (AVX2) alignment and padding
+    kt::aligned_vector<double, 32> weights(std::size_t{ 5 }, 1.5);
+    std::cout << "doubles: capacity " << weights.capacity() << ", address % 32 = "
+              << reinterpret_cast<std::uintptr_t>(weights.data()) % 32 << std::endl;
+
+    // over-aligned elements keep their alignment with the default allocator as well
+    kt::vector<lane_block> blocks{};
+    for (int index{}; index < 10; ++index)
+        blocks.push_back(lane_block{ { static_cast<float>(index) } });
+
+    std::cout << "lane blocks: " << blocks.size() << ", offset in line " << offset_in_line(blocks.data())
+              << ", last first lane " << blocks.back().lanes[0] << std::endl;
+
+    // elements that are not trivially copyable are moved into each new aligned block
+    kt::aligned_vector<std::string> labels{};
+    for (int index{}; index < 20; ++index)
+        labels.push_back("label " + std::to_string(index));
+
+    std::cout << "strings: capacity " << labels.capacity() << ", offset in line "
+              << offset_in_line(labels.data()) << ", last " << labels.back() << std::endl;
+
+    return 0;
+}
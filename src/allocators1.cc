@@ -0,0 +1,96 @@
+#include <string>
+#include <cstdlib>
+#include <iostream>
+#include <vector.hh>
+
+// stateful allocator reporting every block it hands out to a shared tally
+struct tally
+{
+    std::size_t allocations{};
+    std::size_t deallocations{};
+    std::size_t bytes{};
+};
+
+template <typename T>
+class counting_allocator
+{
+public:
+    using value_type = T;
+
+    explicit counting_allocator(tally& counters) noexcept
+        :   m_counters{ &counters }
+    {}
+
+    template <typename U>
+    counting_allocator(const counting_allocator<U>& other) noexcept
+        :   m_counters{ other.counters() }
+    {}
+
+    auto allocate(std::size_t count) -> T*
+    {
+        ++(this->m_counters->allocations);
+        this->m_counters->bytes += sizeof(T) * count;
+        return static_cast<T*>(std::malloc(sizeof(T) * count));
+    }
+
+    auto deallocate(T* ptr, std::size_t) noexcept -> void
+    {
+        ++(this->m_counters->deallocations);
+        std::free(ptr);
+    }
+
+    auto counters() const noexcept -> tally* { return this->m_counters; }
+
+private:
+    tally* m_counters;
+};
+
+template <typename T, typename U>
+auto operator==(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) noexcept -> bool
+{
+    return lhs.counters() == rhs.counters();
+}
+
+template <typename T, typename U>
+auto operator!=(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) noexcept -> bool
+{
+    return !(lhs == rhs);
+}
+
+int main(int, char**) {
+    tally counters{};
+
+    {
+        kt::vector<int, counting_allocator<int>> numbers{ counting_allocator<int>{ counters } };
+        // the strings are sized up front and then assigned in place
+        kt::vector<std::string, counting_allocator<std::string>> words(std::size_t{ 100 }, std::string{},
+                                                                       counting_allocator<std::string>{ counters });
+
+        for (int index{}; index < 100; ++index)
+        {
+            numbers.push_back(index);
+            words[static_cast<std::size_t>(index)] = "word " + std::to_string(index);
+        }
+
+        // copies ask the source allocator which allocator they get, here the same tally
+        const auto copy{ words };
+        std::cout << "copy shares the tally: " << std::boolalpha
+                  << (copy.get_allocator().counters() == &counters) << std::endl;
+    }
+
+    std::cout << "allocations: " << counters.allocations << ", deallocations: " << counters.deallocations
+              << ", bytes requested: " << counters.bytes << std::endl;
+
+    // short lived vectors carved out of a stack buffer, no heap involved
+    alignas(std::max_align_t) unsigned char buffer[4096];
+    kt::arena scratch{ buffer, sizeof(buffer) };
+
+    kt::vector<double, kt::arena_allocator<double>> samples{ kt::arena_allocator<double>{ scratch } };
+    for (int index{}; index < 64; ++index)
+        samples.push_back(0.5 * index);
+
+    std::cout << "arena samples: " << samples.size() << ", last " << samples.back()
+              << ", bytes left in the arena: " << scratch.available() << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <thread>
+#include <cstdint>
+#include <iostream>
+#include <vector.hh>
+#include <bounded_queue.hh>
+
+// ingest -> processing pipeline: handoffs take no lock and allocate nothing after setup
+int main(int, char**) {
+    constexpr std::uint64_t RECORDS{ 100000 };
+    constexpr std::size_t BATCH{ 32 };
+    constexpr std::size_t WORKERS{ 3 };
+
+    kt::spsc_queue<std::uint64_t> ingest{ 1024 };
+    kt::mpmc_queue<std::uint64_t> results{ 1024 };
+
+    // one reader hands records over in batches
+    std::thread reader{ [&ingest]() -> void {
+        std::uint64_t batch[BATCH];
+
+        for (std::uint64_t next{}; next < RECORDS; )
+        {
+            std::size_t count{};
+            for (; count < BATCH && next + count < RECORDS; ++count)
+                batch[count] = next + count;
+
+            const std::size_t pushed{ ingest.try_push_n(batch, count) };
+
+            if (pushed == 0)
+                std::this_thread::yield();
+            next += pushed;
+        }
+    } };
+
+    // a dispatcher fans them out to the workers, which send back their squares
+    kt::vector<std::thread> workers{};
+    kt::mpmc_queue<std::uint64_t> work{ 256 };
+
+    for (std::size_t worker{}; worker < WORKERS; ++worker)
+        workers.emplace_back([&work, &results]() -> void {
+            std::uint64_t record{};
+
+            for (;;)
+            {
+                if (!work.try_pop(record))
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                // end of stream marker
+                if (record == RECORDS)
+                    return;
+
+                while (!results.try_push(record * record))
+                    std::this_thread::yield();
+            }
+        });
+
+    std::uint64_t total{};
+    std::uint64_t received{};
+    std::uint64_t records[BATCH];
+    std::uint64_t squares[BATCH];
+    std::size_t pending{};
+    std::size_t dispatched{};
+
+    // never wait on one queue alone: workers blocked on a full result queue need it drained
+    while (received < RECORDS)
+    {
+        if (dispatched == pending)
+        {
+            pending = ingest.try_pop_n(records, BATCH);
+            dispatched = 0;
+        }
+
+        dispatched += work.try_push_n(records + dispatched, pending - dispatched);
+
+        const std::size_t done{ results.try_pop_n(squares, BATCH) };
+        for (std::size_t index{}; index < done; ++index)
+            total += squares[index];
+        received += done;
+    }
+
+    for (std::size_t worker{}; worker < WORKERS; ++worker)
+        while (!work.try_push(RECORDS)) {}
+
+    reader.join();
+    for (auto& worker : workers)
+        worker.join();
+
+    std::cout << "records: " << received << ", sum of squares: " << total
+              << " (expected " << (RECORDS - 1) * RECORDS * (2 * RECORDS - 1) / 6 << ")" << std::endl;
+
+    return 0;
+}
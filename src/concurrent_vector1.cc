@@ -0,0 +1,37 @@
+#include <thread>
+#include <iostream>
+#include <vector.hh>
+#include <concurrent_vector.hh>
+
+int main(int, char**) {
+    constexpr std::size_t THREADS{ 4 };
+    constexpr std::size_t PER_THREAD{ 10000 };
+
+    kt::concurrent_vector<std::size_t> results{};
+    kt::vector<std::thread> workers{};
+    kt::vector<std::size_t*> firsts(THREADS, static_cast<std::size_t*>(nullptr));
+
+    for (std::size_t thread{}; thread < THREADS; ++thread)
+        workers.emplace_back([&results, &firsts, thread]() -> void {
+            firsts[thread] = &results.push_back(thread);
+
+            for (std::size_t index{ 1 }; index < PER_THREAD; ++index)
+                results.push_back(thread);
+        });
+
+    for (auto& worker : workers)
+        worker.join();
+
+    std::size_t total{};
+    for (auto value : results)
+        total += value;
+
+    std::cout << "size: " << results.size() << " capacity: " << results.capacity() << std::endl;
+    std::cout << "sum of thread ids: " << total << std::endl;
+
+    // references taken while other threads kept appending are still valid
+    for (std::size_t thread{}; thread < THREADS; ++thread)
+        std::cout << "first element pushed by thread " << thread << ": " << *firsts[thread] << std::endl;
+
+    return 0;
+}
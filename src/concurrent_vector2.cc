@@ -0,0 +1,99 @@
+#include <new>
+#include <string>
+#include <iostream>
+#include <stdexcept>
+#include <concurrent_vector.hh>
+
+// allocator refusing to hand out more than a fixed number of blocks
+template <typename T>
+struct limited_allocator
+{
+    using value_type = T;
+
+    static inline int budget{ 2 };
+
+    limited_allocator() noexcept = default;
+
+    template <typename U>
+    limited_allocator(const limited_allocator<U>&) noexcept {}
+
+    auto allocate(std::size_t count) -> T*
+    {
+        if (budget == 0)
+            return nullptr;
+
+        --budget;
+        return static_cast<T*>(std::malloc(sizeof(T) * count));
+    }
+
+    auto deallocate(T* ptr, std::size_t) noexcept -> void { std::free(ptr); }
+
+    friend auto operator==(const limited_allocator&, const limited_allocator&) noexcept -> bool { return true; }
+    friend auto operator!=(const limited_allocator&, const limited_allocator&) noexcept -> bool { return false; }
+};
+
+// label whose copies start failing after a few of them
+struct label
+{
+    static inline int copies_left{ 3 };
+
+    std::string text{ "default" };
+
+    label() noexcept = default;
+    explicit label(std::string value) : text{ std::move(value) } {}
+
+    label(const label& other)
+        :   text{ other.text }
+    {
+        if (copies_left-- == 0)
+            throw std::runtime_error("copy failed");
+    }
+};
+
+int main(int, char**) {
+    {
+        // the first two segments hold 8 + 16 elements, the third one cannot be allocated
+        kt::concurrent_vector<std::string, limited_allocator<std::string>> names{};
+
+        for (int index{}; index < 24; ++index)
+            names.push_back("name " + std::to_string(index));
+
+        try
+        {
+            names.push_back("one too many");
+        }
+        catch (const std::bad_alloc&)
+        {
+            std::cout << "segment allocation failed, size still " << names.size() << std::endl;
+        }
+
+        try
+        {
+            names.grow_by(4, "four more");
+        }
+        catch (const std::bad_alloc&)
+        {
+            std::cout << "bulk append failed, size still " << names.size()
+                      << ", last element \"" << names[names.size() - 1] << '"' << std::endl;
+        }
+    }
+
+    {
+        kt::concurrent_vector<label> labels{};
+
+        try
+        {
+            labels.grow_by(6, label{ "copied" });
+        }
+        catch (const std::runtime_error&)
+        {
+            // every reserved slot holds a live element, destroying them is safe
+            std::cout << "bulk append threw after 3 copies, size " << labels.size() << ":";
+            for (const auto& item : labels)
+                std::cout << ' ' << item.text;
+            std::cout << std::endl;
+        }
+    }
+
+    return 0;
+}
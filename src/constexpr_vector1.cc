@@ -0,0 +1,62 @@
+#include <cstdint>
+#include <iostream>
+#include <freeze.hh>
+
+// CRC-32 (IEEE 802.3) lookup table, computed by the compiler and stored in read only data
+static constexpr auto crc_table{ kt::freeze([] {
+    kt::vector<std::uint32_t> table{};
+    table.reserve(256);
+
+    for (std::uint32_t byte{}; byte < 256; ++byte)
+    {
+        std::uint32_t crc{ byte };
+        for (int bit{}; bit < 8; ++bit)
+            crc = (crc & 1) != 0 ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+
+        table.push_back(crc);
+    }
+
+    return table;
+}) };
+
+static_assert(crc_table.size() == 256 && crc_table[1] == 0x77073096u);
+
+// the first primes, the sieve grows a vector with insert and erase_if at compile time
+static constexpr auto primes{ kt::freeze([] {
+    kt::vector<int> numbers{};
+    numbers.insert(numbers.end(), 199, 0);
+
+    for (std::size_t index{}; index < numbers.size(); ++index)
+        numbers[index] = static_cast<int>(index) + 2;
+
+    for (std::size_t index{}; index < numbers.size(); ++index)
+    {
+        const int prime{ numbers[index] };
+        numbers.erase_if([prime](int value) -> bool { return value != prime && value % prime == 0; });
+    }
+
+    return numbers;
+}) };
+
+static_assert(primes.size() == 46 && primes.back() == 199);
+
+auto crc32(const char* text) -> std::uint32_t
+{
+    std::uint32_t crc{ 0xFFFFFFFFu };
+
+    for (; *text != '\0'; ++text)
+        crc = crc_table[(crc ^ static_cast<std::uint8_t>(*text)) & 0xFFu] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+int main(int, char**) {
+    std::cout << std::hex << "crc32(\"123456789\"): 0x" << crc32("123456789") << std::dec << std::endl;
+
+    std::cout << primes.size() << " primes up to 200:";
+    for (const int prime : primes)
+        std::cout << ' ' << prime;
+    std::cout << std::endl;
+
+    return 0;
+}
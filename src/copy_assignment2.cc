@@ -0,0 +1,46 @@
+#include <string>
+#include <iostream>
+#include <vector.hh>
+
+template <typename Container>
+auto show(const char* label, const Container& items) -> void
+{
+    std::cout << label << " (size " << items.size() << ", capacity " << items.capacity() << "):";
+    for (const auto& item : items)
+        std::cout << ' ' << item;
+    std::cout << std::endl;
+}
+
+int main(int, char**) {
+    // trivially copyable elements: copies are a single memcpy
+    kt::vector<int> frame(16, 0);
+    const kt::vector<int> small{ 1, 2, 3, 4 };
+    const auto* buffer{ frame.data() };
+
+    frame = small;
+    show("int frame after assigning 4 elements", frame);
+    std::cout << "buffer reused: " << std::boolalpha << (frame.data() == buffer) << std::endl;
+
+    const kt::vector<int> large(32, 5);
+    frame = large;
+    std::cout << "after assigning 32 elements: capacity " << frame.capacity()
+              << ", buffer reused: " << (frame.data() == buffer) << std::endl;
+
+    // other elements: the common prefix is copy assigned, the rest constructed or destroyed
+    kt::vector<std::string> names{ "ada", "grace", "barbara", "frances", "margaret" };
+    const kt::vector<std::string> fewer{ "edsger", "tony" };
+    const kt::vector<std::string> more{ "alan", "john", "donald", "niklaus" };
+    const auto* names_buffer{ names.data() };
+
+    names = fewer;
+    show("strings after assigning 2", names);
+    names = more;
+    show("strings after assigning 4", names);
+    std::cout << "buffer reused: " << (names.data() == names_buffer) << std::endl;
+
+    const auto& alias{ names };
+    names = alias;
+    show("strings after self assignment", names);
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <string>
+#include <iostream>
+#include <vector.hh>
+
+// counts destructions, to show every removed element is destroyed exactly once
+struct tracked
+{
+    static inline int destroyed{};
+
+    explicit tracked(int value) : value{ value } { }
+    tracked(const tracked&) = default;
+    tracked(tracked&&) noexcept = default;
+    auto operator=(const tracked&) -> tracked& = default;
+    auto operator=(tracked&&) noexcept -> tracked& = default;
+    ~tracked() { ++destroyed; }
+
+    int value{};
+};
+
+int main(int, char**) {
+    kt::vector<int> numbers{};
+    for (int value{}; value < 20; ++value)
+        numbers.push_back(value);
+
+    // one pass over the vector, survivors keep their order
+    const auto odd{ numbers.erase_if([](int value) { return value % 2 != 0; }) };
+    std::cout << "removed " << odd << " odd numbers, left:";
+    for (const auto value : numbers)
+        std::cout << ' ' << value;
+    std::cout << std::endl;
+
+    numbers.remove_n(4);
+    std::cout << "after remove_n(4) the size is " << numbers.size()
+              << ", the last element is " << numbers.back() << std::endl;
+
+    numbers.remove_n(100);
+    std::cout << "after remove_n(100) the size is " << numbers.size() << std::endl;
+
+    {
+        kt::vector<tracked> items{};
+        items.reserve(10);
+        for (int value{}; value < 10; ++value)
+            items.emplace_back(value);
+
+        tracked::destroyed = 0;
+        const auto removed{ items.erase_if([](const tracked& item) { return item.value < 3 || item.value > 7; }) };
+        std::cout << "erase_if removed " << removed << " tracked items, destructors run: " << tracked::destroyed << std::endl;
+
+        tracked::destroyed = 0;
+        items.remove_n(2);
+        std::cout << "remove_n(2) destructors run: " << tracked::destroyed << ", left:";
+        for (const auto& item : items)
+            std::cout << ' ' << item.value;
+        std::cout << std::endl;
+
+        tracked::destroyed = 0;
+    }
+    std::cout << "destructors run when the vector went out of scope: " << tracked::destroyed << std::endl;
+
+    kt::vector<std::string> words{ "keep", "", "these", "", "", "words" };
+    std::cout << "removed " << words.erase_if([](const std::string& word) { return word.empty(); })
+              << " empty strings, left " << words.size() << std::endl;
+
+    return 0;
+}
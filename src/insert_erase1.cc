@@ -0,0 +1,55 @@
+#include <string>
+#include <iostream>
+#include <vector.hh>
+
+template <typename Container>
+auto show(const char* label, const Container& items) -> void
+{
+    std::cout << label << ':';
+    for (const auto& item : items)
+        std::cout << ' ' << item;
+    std::cout << std::endl;
+}
+
+int main(int, char**) {
+    kt::vector<int> numbers{ 1, 2, 6 };
+
+    // positional inserts shift the tail instead of rebuilding the vector
+    numbers.insert(numbers.cbegin() + 2, 5);
+    numbers.insert(numbers.cbegin() + 2, { 3, 4 });
+    numbers.insert(numbers.cend(), 2, 7);
+    show("numbers after inserts", numbers);
+
+    const int extra[]{ 10, 20, 30 };
+    numbers.insert(numbers.cbegin(), std::begin(extra), std::end(extra));
+    show("numbers after a range insert at the front", numbers);
+
+    numbers.erase(numbers.cbegin(), numbers.cbegin() + 3);
+    numbers.erase(numbers.cend() - 1);
+    show("numbers after erasing the range and the last element", numbers);
+
+    // an element of the vector itself may be the value inserted, even if the buffer moves
+    numbers.shrink_to_fit();
+    numbers.insert(numbers.cbegin(), numbers.back());
+    numbers.insert(numbers.cend(), 3, numbers.front());
+    show("numbers after inserting its own elements", numbers);
+
+    kt::vector<std::string> words{ "one", "three", "five" };
+    words.insert(words.cbegin() + 1, std::string{ "two" });
+    words.emplace(words.cbegin() + 3, "four");
+    words.insert(words.cbegin(), { "zero", "half" });
+    show("words after inserts", words);
+
+    words.erase(words.cbegin() + 1);
+    show("words after erasing \"half\"", words);
+
+    // erase_unordered fills the gap with the last element, no shifting
+    words.erase_unordered(words.cbegin());
+    show("words after erase_unordered of the front", words);
+
+    words.insert(words.cbegin() + 1, 2, words[0]);
+    words.erase(words.cbegin() + 1, words.cend() - 1);
+    show("words after a self insert and a range erase", words);
+
+    return 0;
+}
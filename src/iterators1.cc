@@ -0,0 +1,54 @@
+#include <string>
+#include <numeric>
+#include <iterator>
+#include <iostream>
+#include <algorithm>
+#include <vector.hh>
+
+using int_iterator = kt::vector<int>::iterator_type;
+using string_iterator = kt::vector<std::string>::const_iterator_type;
+
+static_assert(std::is_same_v<std::iterator_traits<int_iterator>::iterator_category, std::random_access_iterator_tag>);
+static_assert(std::is_same_v<std::iterator_traits<string_iterator>::reference, const std::string&>);
+static_assert(std::is_convertible_v<int_iterator, kt::vector<int>::const_iterator_type>);
+
+#if __cplusplus >= 202002L
+static_assert(std::contiguous_iterator<int_iterator>);
+static_assert(std::contiguous_iterator<string_iterator>);
+#endif
+
+int main(int, char**) {
+    kt::vector<int> numbers{ 42, 7, 19, 3, 88, 23, 7, 61 };
+
+    std::sort(numbers.begin(), numbers.end());
+    const auto found{ std::lower_bound(numbers.cbegin(), numbers.cend(), 23) };
+
+    std::cout << "sorted:";
+    for (const auto value : numbers)
+        std::cout << ' ' << value;
+    std::cout << ", 23 at index " << (found - numbers.cbegin())
+              << ", sum " << std::accumulate(numbers.begin(), numbers.end(), 0) << std::endl;
+
+    // std::copy between vectors through their random access iterators
+    kt::vector<int> copy(numbers.size());
+    std::copy(numbers.begin(), numbers.end(), copy.begin());
+    std::cout << "copied in reverse:";
+    for (auto value{ std::make_reverse_iterator(copy.end()) }; value != std::make_reverse_iterator(copy.begin()); ++value)
+        std::cout << ' ' << *value;
+    std::cout << std::endl;
+
+    kt::vector<std::string> words{ "pear", "fig", "apple", "kiwi", "banana" };
+
+    std::sort(words.begin(), words.end(), [](const std::string& lhs, const std::string& rhs) -> bool {
+        return lhs.size() < rhs.size() || (lhs.size() == rhs.size() && lhs < rhs);
+    });
+    std::rotate(words.begin(), words.begin() + 2, words.end());
+
+    std::cout << "strings by length, rotated by 2:";
+    for (string_iterator word{ words.cbegin() }; word != words.cend(); ++word)
+        std::cout << ' ' << *word;
+    std::cout << ", third from the end: " << *(words.end() - 3)
+              << ", distance " << std::distance(words.begin(), words.end()) << std::endl;
+
+    return 0;
+}
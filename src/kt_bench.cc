@@ -0,0 +1,232 @@
+// Micro benchmarks of kt::vector against std::vector. Results are written to stdout as JSON:
+//
+//   kt_bench [--elements N] [--repetitions R]
+//
+// Every case is run R times and the fastest and median times are reported, along with the
+// kt::vector / std::vector ratio of the medians (below 1.0 means kt::vector is faster).
+
+#include <chrono>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+#include <vector.hh>
+
+namespace {
+
+    using clock_type = std::chrono::steady_clock;
+
+    struct options
+    {
+        std::size_t elements{ 1'000'000 };
+        std::size_t repetitions{ 15 };
+    };
+
+    struct measurement
+    {
+        double min_ns;
+        double median_ns;
+    };
+
+    // keeps the optimizer from discarding the results of the measured code
+    template <typename T>
+    inline auto escape(T&& value) -> void
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void* sink{};
+        sink = &value;
+#endif
+    }
+
+    template <typename T>
+    auto make_value(std::size_t index) -> T
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return std::string(32, static_cast<char>('a' + index % 26)); // beyond the small string buffer
+        else
+            return static_cast<T>(index);
+    }
+
+    template <typename T>
+    auto weight(const T& value) -> std::size_t
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return value.size();
+        else
+            return static_cast<std::size_t>(value);
+    }
+
+    template <typename T>
+    auto append(kt::vector<T>& target, const kt::vector<T>& source) -> void
+    {
+        target.append(source);
+    }
+
+    template <typename T>
+    auto append(std::vector<T>& target, const std::vector<T>& source) -> void
+    {
+        target.insert(target.end(), source.begin(), source.end());
+    }
+
+    template <typename Container>
+    auto filled(std::size_t count) -> Container
+    {
+        using T = typename Container::value_type;
+
+        Container items{};
+        items.reserve(count);
+
+        for (std::size_t index{}; index < count; ++index)
+            items.push_back(make_value<T>(index));
+
+        return items;
+    }
+
+    /**
+     * Runs <code>setup</code> then times <code>body</code>, <code>repetitions</code> times.
+     * Only <code>body</code> is measured, <code>setup</code> returns the state it works on.
+     * */
+    template <typename Setup, typename Body>
+    auto measure(std::size_t repetitions, Setup setup, Body body) -> measurement
+    {
+        std::vector<double> samples{};
+        samples.reserve(repetitions);
+
+        for (std::size_t repetition{}; repetition < repetitions; ++repetition)
+        {
+            auto state{ setup() };
+
+            const auto start{ clock_type::now() };
+            body(state);
+            const auto stop{ clock_type::now() };
+
+            escape(state);
+            samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+
+        std::sort(samples.begin(), samples.end());
+        return { samples.front(), samples[samples.size() / 2] };
+    }
+
+    template <typename Container>
+    auto run_cases(const options& settings) -> std::vector<std::pair<const char*, measurement>>
+    {
+        using T = typename Container::value_type;
+
+        const std::size_t count{ settings.elements };
+        const std::size_t reps{ settings.repetitions };
+        const Container source{ filled<Container>(count) };
+
+        std::vector<T> values{};
+        for (std::size_t index{}; index < count; ++index)
+            values.push_back(make_value<T>(index));
+
+        constexpr std::size_t CHUNK{ 64 };
+        const Container chunk{ filled<Container>(CHUNK) };
+
+        std::vector<std::pair<const char*, measurement>> results{};
+
+        results.emplace_back("push_back", measure(reps, []() { return Container{}; }, [&](Container& items) {
+            for (std::size_t index{}; index < count; ++index)
+                items.push_back(values[index]);
+        }));
+
+        results.emplace_back("emplace_back", measure(reps, []() { return Container{}; }, [&](Container& items) {
+            for (std::size_t index{}; index < count; ++index)
+                items.emplace_back(make_value<T>(index));
+        }));
+
+        results.emplace_back("copy_construct", measure(reps, []() { return Container{}; }, [&](Container& items) {
+            Container copy{ source };
+            items = std::move(copy);
+        }));
+
+        results.emplace_back("move_construct", measure(reps, [&]() { return Container{ source }; }, [&](Container& items) {
+            Container moved{ std::move(items) };
+
+            // hand the elements back so they are destroyed after the clock stops
+            items = std::move(moved);
+        }));
+
+        results.emplace_back("append", measure(reps, []() { return Container{}; }, [&](Container& items) {
+            for (std::size_t appended{}; appended < count; appended += CHUNK)
+                append(items, chunk);
+        }));
+
+        results.emplace_back("iterate", measure(reps, []() { return std::size_t{}; }, [&](std::size_t& total) {
+            for (const auto& item : source)
+                total += weight(item);
+        }));
+
+        results.emplace_back("reserve_fill", measure(reps, []() { return Container{}; }, [&](Container& items) {
+            items.reserve(count);
+            for (std::size_t index{}; index < count; ++index)
+                items.push_back(values[index]);
+        }));
+
+        return results;
+    }
+
+    template <typename T>
+    auto report(const char* type_name, const options& settings, bool& first_entry) -> void
+    {
+        const auto kt_results{ run_cases<kt::vector<T>>(settings) };
+        const auto std_results{ run_cases<std::vector<T>>(settings) };
+
+        for (std::size_t index{}; index < kt_results.size(); ++index)
+        {
+            const auto& [name, kt_time] = kt_results[index];
+            const auto& std_time{ std_results[index].second };
+
+            std::printf("%s\n    {\"name\": \"%s\", \"type\": \"%s\", \"elements\": %zu, "
+                        "\"kt_min_ns\": %.0f, \"kt_median_ns\": %.0f, "
+                        "\"std_min_ns\": %.0f, \"std_median_ns\": %.0f, \"ratio\": %.3f}",
+                        first_entry ? "" : ",", name, type_name, settings.elements,
+                        kt_time.min_ns, kt_time.median_ns, std_time.min_ns, std_time.median_ns,
+                        kt_time.median_ns / std_time.median_ns);
+
+            first_entry = false;
+        }
+    }
+
+    auto parse(int argc, char** argv) -> options
+    {
+        options settings{};
+
+        for (int index{ 1 }; index + 1 < argc; index += 2)
+        {
+            const std::size_t value{ std::strtoull(argv[index + 1], nullptr, 10) };
+
+            if (std::strcmp(argv[index], "--elements") == 0 && value != 0)
+                settings.elements = value;
+            else if (std::strcmp(argv[index], "--repetitions") == 0 && value != 0)
+                settings.repetitions = value;
+            else
+                std::fprintf(stderr, "ignoring argument %s %s\n", argv[index], argv[index + 1]);
+        }
+
+        return settings;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const options settings{ parse(argc, argv) };
+    bool first_entry{ true };
+
+    std::printf("{\n  \"elements\": %zu,\n  \"repetitions\": %zu,\n  \"benchmarks\": [",
+                settings.elements, settings.repetitions);
+
+    report<int>("int", settings, first_entry);
+    report<std::string>("std::string", settings, first_entry);
+
+    std::printf("\n  ]\n}\n");
+
+    return 0;
+}
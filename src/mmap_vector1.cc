@@ -0,0 +1,33 @@
+#include <iostream>
+#include <mmap_vector.hh>
+
+struct sample
+{
+    std::uint32_t   id;
+    float           value;
+};
+
+int main(int, char**) {
+    using table = kt::mmap_vector<sample>;
+    const char* path{ "mmap_vector1.bin" };
+
+    {
+        table samples{ path, table::open_mode::truncate };
+
+        for (std::uint32_t index{}; index < 100000; ++index)
+            samples.push_back({ index, 0.25f * static_cast<float>(index) });
+
+        std::cout << "written: " << samples.size() << " samples, capacity " << samples.capacity() << std::endl;
+    }
+
+    // a later run (or another process) maps the same table without deserializing it
+    const table samples{ path, table::open_mode::read_only };
+
+    if (!samples.is_open())
+        return 1;
+
+    std::cout << "mapped: " << samples.size() << " samples, last id " << samples.back().id
+              << ", value " << samples[samples.size() - 1].value << std::endl;
+
+    return 0;
+}
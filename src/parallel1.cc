@@ -0,0 +1,32 @@
+#include <iostream>
+#include <parallel.hh>
+
+int main(int, char**) {
+    constexpr std::size_t COUNT{ 1 << 20 };
+
+    kt::vector<std::uint64_t> numbers(COUNT);
+    kt::vector<double> halves(COUNT);
+
+    kt::parallel::fill(numbers, std::uint64_t{ 3 });
+    kt::parallel::for_each(numbers, [](std::uint64_t& value) -> void { value *= 7; });
+    kt::parallel::transform(numbers, halves, [](std::uint64_t value) -> double { return static_cast<double>(value) / 2.0; });
+
+    std::cout << "Worker threads: " << kt::thread_pool::default_pool().size() << std::endl;
+    std::cout << "numbers sum: " << kt::parallel::reduce(numbers, std::uint64_t{ 0 }) << std::endl;
+    std::cout << "halves sum: " << kt::parallel::reduce(halves, 0.0) << std::endl;
+
+    for (std::size_t index{}; index < numbers.size(); ++index)
+        numbers[index] = (index * 2654435761u) % 1000003;
+
+    kt::parallel::sort(numbers);
+    std::cout << "sorted: " << std::boolalpha << std::is_sorted(numbers.begin().raw(), numbers.end().raw()) << std::endl;
+
+    kt::thread_pool pool{ 2 };
+    std::cout << "max with a 2 thread pool: "
+              << kt::parallel::reduce(numbers, std::uint64_t{ 0 },
+                                      [](std::uint64_t lhs, std::uint64_t rhs) -> std::uint64_t { return std::max(lhs, rhs); },
+                                      kt::parallel::automatic_grain, pool)
+              << std::endl;
+
+    return 0;
+}
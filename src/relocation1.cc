@@ -0,0 +1,78 @@
+#include <string>
+#include <iostream>
+#include <vector.hh>
+
+// owns a heap buffer but never points to itself: safe to move by copying its bytes
+class handle
+{
+public:
+    explicit handle(int value) : m_value{ new int{ value } } {}
+    handle(handle&& other) noexcept : m_value{ other.m_value } { other.m_value = nullptr; ++moves; }
+    handle(const handle&) = delete;
+    ~handle() { delete this->m_value; }
+
+    auto value() const noexcept -> int { return *this->m_value; }
+
+    static inline int moves{};
+
+private:
+    int* m_value;
+};
+
+template <>
+struct kt::is_trivially_relocatable<handle> : std::true_type {};
+
+// its move may throw, so growing must copy it to keep the old elements intact on failure
+struct legacy
+{
+    explicit legacy(int id) : text{ std::to_string(id) } {}
+    legacy(const legacy& other) : text{ other.text } { ++copies; }
+    legacy(legacy&& other) : text{ std::move(other.text) } { ++moves; }
+
+    std::string text;
+
+    static inline int copies{};
+    static inline int moves{};
+};
+
+auto describe(kt::detail::relocation kind) -> const char*
+{
+    switch (kind)
+    {
+        case kt::detail::relocation::realloc:   return "realloc";
+        case kt::detail::relocation::memcpy:    return "memcpy";
+        case kt::detail::relocation::move:      return "move";
+    }
+
+    return "unknown";
+}
+
+int main(int, char**) {
+    using kt::detail::relocation_for;
+
+    std::cout << "int:         " << describe(relocation_for<int, kt::allocator<int>>) << std::endl;
+    std::cout << "handle:      " << describe(relocation_for<handle, kt::allocator<handle>>) << std::endl;
+    std::cout << "std::string: " << describe(relocation_for<std::string, kt::allocator<std::string>>) << std::endl;
+    std::cout << "legacy:      " << describe(relocation_for<legacy, kt::allocator<legacy>>) << std::endl;
+
+    kt::vector<int> numbers{};
+    kt::vector<handle> handles{};
+    kt::vector<std::string> names{};
+    kt::vector<legacy> records{};
+
+    for (int index{}; index < 1000; ++index)
+    {
+        numbers.push_back(index);
+        handles.emplace_back(index);
+        names.push_back("name " + std::to_string(index));
+        records.emplace_back(index);
+    }
+
+    // handles are built in place and relocated with memcpy, their move constructor never runs
+    std::cout << "handle moves while growing: " << handle::moves << ", last " << handles.back().value() << std::endl;
+    std::cout << "legacy copies while growing: " << legacy::copies << ", moves: " << legacy::moves
+              << ", last " << records.back().text << std::endl;
+    std::cout << "numbers: " << numbers.size() << ", names: " << names.size() << ", last " << names.back() << std::endl;
+
+    return 0;
+}
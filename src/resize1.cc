@@ -0,0 +1,85 @@
+#include <string>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <vector.hh>
+
+template <typename Container>
+auto show(const char* label, const Container& items) -> void
+{
+    std::cout << label << " (size " << items.size() << "):";
+    for (const auto& item : items)
+        std::cout << ' ' << item;
+    std::cout << std::endl;
+}
+
+// copies start failing after a few of them
+struct fragile
+{
+    static inline int copies_left{ 3 };
+
+    int value{};
+
+    fragile() = default;
+    explicit fragile(int init) : value{ init } {}
+
+    fragile(const fragile& other)
+        :   value{ other.value }
+    {
+        if (copies_left-- == 0)
+            throw std::runtime_error("copy failed");
+    }
+};
+
+int main(int, char**) {
+    kt::vector<int> numbers{ 1, 2, 3 };
+
+    numbers.resize(6);
+    show("int resize(6), value initialized", numbers);
+    numbers.resize(8, 9);
+    show("int resize(8, 9)", numbers);
+    numbers.resize(2);
+    show("int resize(2)", numbers);
+
+    kt::vector<std::string> words{ "alpha" };
+
+    words.resize(3, "beta");
+    show("string resize(3, \"beta\")", words);
+    words.resize(1);
+    show("string resize(1)", words);
+
+    // the bytes are about to be overwritten, zeroing them first would be wasted work
+    std::FILE* file{ std::tmpfile() };
+
+    if (file == nullptr)
+        return 1;
+
+    std::fputs("read straight into the vector", file);
+    std::rewind(file);
+
+    kt::vector<char> bytes{};
+    bytes.resize_for_overwrite(64);
+    bytes.resize(std::fread(bytes.data(), 1, bytes.size(), file));
+    std::fclose(file);
+
+    std::cout << "char resize_for_overwrite: \"" << std::string(bytes.data(), bytes.size()) << '"' << std::endl;
+
+    // elements that are not trivially constructible are still value initialized
+    words.resize_for_overwrite(3);
+    std::cout << "string resize_for_overwrite(3): \"" << words[0] << "\", \"" << words[1] << "\", \""
+              << words[2] << '"' << std::endl;
+
+    // a failing copy leaves the vector as it was
+    kt::vector<fragile> items(2, fragile{ 7 });
+
+    try
+    {
+        items.resize(10, fragile{ 8 });
+    }
+    catch (const std::runtime_error&)
+    {
+        std::cout << "resize with a failing copy kept size " << items.size() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <deque.hh>
+
+// sample window of a sensor: new readings at the back, the oldest ones are consumed in bulk
+int main(int, char**) {
+    kt::ring_buffer<std::int32_t> samples{};
+
+    for (std::int32_t reading{}; reading < 8; ++reading)
+        samples.push_back(reading);
+
+    samples.pop_front_n(5);
+
+    for (std::int32_t reading{ 8 }; reading < 12; ++reading)
+        samples.push_back(reading);
+
+    // the window wrapped around the end of the block: at most two contiguous runs
+    const auto [older, newer]{ samples.spans() };
+    const auto total{ std::accumulate(older.data(), older.data() + older.size(), std::int64_t{})
+                    + std::accumulate(newer.data(), newer.data() + newer.size(), std::int64_t{}) };
+
+    std::cout << "runs of " << older.size() << " and " << newer.size()
+              << " samples, capacity " << samples.capacity() << ", sum " << total << std::endl;
+    samples.pop_front_n(older.size());
+
+    kt::deque<std::int32_t> undo{};
+
+    for (std::int32_t step{ 1 }; step <= 6; ++step)
+        undo.push_back(step);
+
+    undo.pop_back();
+    undo.push_front(0);
+
+    std::cout << "undo history:";
+    for (kt::deque<std::int32_t>::const_iterator_type step{ undo.begin() }; step != undo.cend(); ++step)
+        std::cout << ' ' << *step;
+    std::cout << ", two steps back: " << *(2 + undo.begin()) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+#include <serialize.hh>
+
+namespace {
+
+    auto describe(kt::serialization_status status) -> const char*
+    {
+        switch (status)
+        {
+            case kt::serialization_status::ok:                  return "ok";
+            case kt::serialization_status::io_error:            return "io_error";
+            case kt::serialization_status::bad_magic:           return "bad_magic";
+            case kt::serialization_status::version_mismatch:    return "version_mismatch";
+            case kt::serialization_status::layout_mismatch:     return "layout_mismatch";
+            case kt::serialization_status::byte_order_mismatch: return "byte_order_mismatch";
+            case kt::serialization_status::corrupt:             return "corrupt";
+            case kt::serialization_status::out_of_memory:       return "out_of_memory";
+        }
+
+        return "unknown";
+    }
+
+    // reads back whatever a temporary file holds, from its beginning
+    auto read_back(std::FILE* file, kt::vector<std::uint64_t>& items) -> kt::serialization_status
+    {
+        std::fflush(file);
+        ::lseek(::fileno(file), 0, SEEK_SET);
+        return kt::deserialize(::fileno(file), items);
+    }
+
+    // overwrites the count stored in the header of a serialized vector
+    auto forge_count(std::FILE* file, std::uint64_t count) -> void
+    {
+        std::fflush(file);
+        ::pwrite(::fileno(file), &count, sizeof(count), offsetof(kt::serialization_header, count));
+    }
+
+}
+
+int main(int, char**) {
+    kt::vector<std::uint64_t> sent{};
+
+    for (std::uint64_t index{}; index < 1000; ++index)
+        sent.push_back(index * index);
+
+    std::FILE* file{ std::tmpfile() };
+
+    if (file == nullptr)
+        return 1;
+
+    kt::serialize(::fileno(file), sent);
+
+    kt::vector<std::uint64_t> received{};
+    auto status{ read_back(file, received) };
+
+    std::cout << "round trip: " << describe(status) << ", " << received.size() << " elements, last "
+              << received.back() << std::endl;
+
+    // a header claiming more elements than the file holds, e.g. a transfer cut short
+    forge_count(file, 1001);
+    status = read_back(file, received);
+    std::cout << "truncated payload: " << describe(status) << ", vector kept " << received.size() << " elements" << std::endl;
+
+    // a count whose size in bytes would wrap around to a tiny allocation
+    forge_count(file, std::uint64_t{ 1 } << 61);
+    status = read_back(file, received);
+    std::cout << "oversized count: " << describe(status) << ", vector kept " << received.size() << " elements" << std::endl;
+
+    std::fclose(file);
+
+    return 0;
+}
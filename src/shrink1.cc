@@ -0,0 +1,57 @@
+#include <string>
+#include <iostream>
+#include <vector.hh>
+
+int main(int, char**) {
+    // shrink_to_fit gives back the unused tail of the buffer
+    kt::vector<int> numbers{};
+    numbers.reserve(1000);
+    for (int value{}; value < 10; ++value)
+        numbers.push_back(value);
+
+    std::cout << "numbers capacity before shrink_to_fit: " << numbers.capacity() << std::endl;
+    numbers.shrink_to_fit();
+    std::cout << "numbers capacity after shrink_to_fit: " << numbers.capacity() << std::endl;
+
+    kt::vector<std::string> words{ "alpha", "beta", "gamma", "delta" };
+    words.reserve(64);
+    words.pop_back();
+    words.shrink_to_fit();
+    std::cout << "words after shrink_to_fit (capacity " << words.capacity() << "):";
+    for (const auto& word : words)
+        std::cout << ' ' << word;
+    std::cout << std::endl;
+
+    // with the default policy clear() keeps the buffer, so refilling does not allocate
+    words.clear();
+    std::cout << "words capacity after clear: " << words.capacity() << std::endl;
+    words.shrink_to_fit();
+    std::cout << "words capacity after clear and shrink_to_fit: " << words.capacity() << std::endl;
+
+    // a shrinking policy cuts the buffer to twice the size once the size falls to a quarter,
+    // so popping and pushing around one boundary does not reallocate each time
+    kt::vector<int, kt::allocator<int>, kt::growth::shrinking<>> queue(8192, 1);
+    std::cout << "shrinking capacities while popping:";
+    while (!queue.empty())
+    {
+        const auto before{ queue.capacity() };
+        queue.pop_back();
+
+        if (queue.capacity() != before)
+            std::cout << ' ' << queue.capacity();
+    }
+    std::cout << std::endl;
+
+    kt::vector<std::string, kt::allocator<std::string>, kt::growth::shrinking<kt::growth::doubling, 4, 256>> names{};
+    for (int index{}; index < 200; ++index)
+        names.push_back("name " + std::to_string(index));
+
+    std::cout << "names capacity: " << names.capacity();
+    while (names.size() > 10)
+        names.pop_back();
+    std::cout << ", after popping down to 10: " << names.capacity();
+    names.clear();
+    std::cout << ", after clear: " << names.capacity() << std::endl;
+
+    return 0;
+}
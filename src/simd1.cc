@@ -0,0 +1,33 @@
+#include <iostream>
+#include <simd.hh>
+
+int main(int, char**) {
+    kt::vector<float> floats(1000);
+    kt::vector<double> doubles{ 1.3, 2.33, 5.11, -34.22, 5.22, 7.11 };
+    kt::vector<std::size_t> numbers{ 22, 44, 44, 111, 451, 0xFFAB, 34, 0b11 };
+
+    for (std::size_t index{}; index < floats.size(); ++index)
+        floats[index] = 0.5f * static_cast<float>(index % 100);
+
+    std::cout << "Detected instruction set: " << static_cast<int>(kt::simd::detected_isa()) << std::endl;
+
+    std::cout << "floats sum: " << kt::simd::sum(floats) << std::endl;
+    std::cout << "floats dot floats: " << kt::simd::dot(floats, floats) << std::endl;
+    std::cout << "floats min: " << kt::simd::min(floats) << " max: " << kt::simd::max(floats) << std::endl;
+    std::cout << "count of 2.5 in floats: " << kt::simd::count(floats, 2.5f) << std::endl;
+
+    std::cout << "doubles min: " << kt::simd::min(doubles) << " max: " << kt::simd::max(doubles) << std::endl;
+
+    std::cout << "index of 451 in numbers: " << kt::simd::find(numbers, std::size_t{ 451 }) << std::endl;
+    std::cout << "count of 44 in numbers: " << kt::simd::count(numbers.cbegin(), numbers.cend(), std::size_t{ 44 }) << std::endl;
+
+    // mutable iterators of a non-const vector, here over the second half only
+    const auto middle{ floats.begin() + static_cast<std::ptrdiff_t>(floats.size() / 2) };
+    std::cout << "second half sum: " << kt::simd::sum(middle, floats.end())
+              << " min: " << kt::simd::min(middle, floats.end())
+              << " max: " << kt::simd::max(middle, floats.end()) << std::endl;
+    std::cout << "second half dot first half: " << kt::simd::dot(middle, floats.end(), floats.begin()) << std::endl;
+    std::cout << "count of 44 via iterators: " << kt::simd::count(numbers.begin(), numbers.end(), std::size_t{ 44 }) << std::endl;
+
+    return 0;
+}
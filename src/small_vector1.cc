@@ -0,0 +1,73 @@
+#include <iostream>
+#include <string>
+#include <small_vector.hh>
+
+template<typename InputIt>
+auto show(InputIt first, InputIt last) {
+    while (first != last)
+        std::cout << *(first++) << ' ';
+}
+
+int main(int, char**) {
+    kt::small_vector<std::string, 4> names{ "ada", "grace" };
+
+    std::cout << "names.size(): " << names.size() << std::endl;
+    std::cout << "names.capacity(): " << names.capacity() << std::endl;
+    std::cout << "names.is_inline(): " << std::boolalpha << names.is_inline() << std::endl;
+
+    names.push_back("barbara");
+    names.push_back("frances");
+
+    std::cout << "After filling the inline buffer: ";
+    show(names.begin(), names.end());
+    std::cout << "\nnames.is_inline(): " << names.is_inline() << std::endl;
+
+    names.emplace_back("margaret");
+
+    std::cout << "After spilling to the heap: ";
+    show(names.begin(), names.end());
+    std::cout << "\nnames.capacity(): " << names.capacity() << std::endl;
+    std::cout << "names.is_inline(): " << names.is_inline() << std::endl;
+
+    kt::small_vector<std::string, 4> moved{ std::move(names) };
+    std::cout << "Moved vector: ";
+    show(moved.begin(), moved.end());
+    std::cout << "\nSize of moved from vector: " << names.size() << std::endl;
+
+    kt::small_vector<int, 8> ints(3, 7);
+    ints.resize(6, 1);
+    std::cout << "ints after resize(6, 1): ";
+    show(ints.begin(), ints.end());
+    std::cout << std::endl;
+
+    // past the inline buffer the heap block grows by half instead of doubling
+    kt::small_vector<int, 4, kt::allocator<int>, kt::growth::one_and_half> gentle{};
+    std::cout << "capacities growing by half:";
+    for (int value{}; value < 40; ++value)
+    {
+        const auto before{ gentle.capacity() };
+        gentle.push_back(value);
+
+        if (gentle.capacity() != before)
+            std::cout << ' ' << gentle.capacity();
+    }
+    std::cout << std::endl;
+
+    // repeated appends reallocate a logarithmic number of times, not once per call
+    kt::small_vector<std::string, 2> log{ "boot" };
+    const kt::small_vector<std::string, 2> entry{ "tick", "tock" };
+    std::size_t reallocations{};
+
+    for (int round{}; round < 100; ++round)
+    {
+        const auto before{ log.capacity() };
+        log.append(entry);
+        reallocations += log.capacity() != before ? 1 : 0;
+    }
+
+    log.append(log);
+    std::cout << "log size after 100 appends and a self append: " << log.size()
+              << ", reallocations: " << reallocations << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,34 @@
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <soa_vector.hh>
+
+int main(int, char**) {
+    // id, price, quantity and name of every order, one contiguous column each
+    kt::soa_vector<std::uint32_t, double, std::uint32_t, std::string> orders{};
+
+    for (std::uint32_t index{}; index < 10000; ++index)
+        orders.emplace_back(index, 0.01 * index, index % 7, "order " + std::to_string(index));
+
+    // scanning two columns touches only their cache lines
+    double total{};
+    const auto prices{ orders.column<1>() };
+    const auto quantities{ orders.column<2>() };
+
+    for (std::size_t index{}; index < orders.size(); ++index)
+        total += prices[index] * quantities[index];
+
+    std::cout << "orders: " << orders.size() << ", total: " << total << std::endl;
+
+    for (auto [id, price, quantity, name] : orders)
+        if (id % 2500 == 0)
+            std::cout << name << ": " << quantity << " x " << price << std::endl;
+
+    // rows are proxies, single pass algorithms take them by value
+    const auto empty_orders{ std::count_if(orders.begin(), orders.end(), [](auto row) -> bool {
+        return std::get<2>(row) == 0;
+    }) };
+    std::cout << "orders without quantity: " << empty_orders << std::endl;
+
+    return 0;
+}
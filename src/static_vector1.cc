@@ -0,0 +1,43 @@
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <static_vector.hh>
+
+// fixed size wire format: the whole struct can be memcpy'd into a packet
+struct route
+{
+    std::uint32_t                           destination;
+    kt::static_vector<std::uint16_t, 8>     hops;
+};
+
+static_assert(std::is_trivially_copyable_v<route>);
+
+int main(int, char**) {
+    route outgoing{ 0x0A000001u, {} };
+
+    for (std::uint16_t hop{ 1 }; ; ++hop)
+    {
+        // no allocation and no silent drop: a full list is reported
+        if (outgoing.hops.try_push_back(hop * 100) == nullptr)
+        {
+            std::cout << "route is full after " << outgoing.hops.size() << " hops" << std::endl;
+            break;
+        }
+    }
+
+    unsigned char packet[sizeof(route)];
+    std::memcpy(packet, &outgoing, sizeof(route));
+
+    route incoming{};
+    std::memcpy(&incoming, packet, sizeof(route));
+
+    incoming.hops.erase(incoming.hops.begin());
+    incoming.hops.erase_unordered(incoming.hops.begin());
+
+    std::cout << "sizeof(route): " << sizeof(route) << ", received hops:";
+    for (const auto hop : incoming.hops)
+        std::cout << ' ' << hop;
+    std::cout << std::endl;
+
+    return 0;
+}
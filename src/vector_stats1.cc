@@ -0,0 +1,25 @@
+#include <string>
+#include <iostream>
+#include <vector.hh>
+
+struct parsed_tokens;
+
+int main(int, char**) {
+    kt::stats::report_at_exit();
+
+    {
+        kt::vector<int> numbers{};
+        for (int index{}; index < 1000; ++index)
+            numbers.push_back(index);
+
+        kt::vector<std::string, kt::allocator<std::string>, kt::stats::tagged<parsed_tokens>> tokens{};
+        tokens.reserve(16);
+        for (int index{}; index < 20; ++index)
+            tokens.push_back("token number " + std::to_string(index));
+
+        std::cout << "numbers: " << numbers.size() << ", tokens: " << tokens.size() << std::endl;
+    }
+
+    // the report is written to stderr once main returns
+    return 0;
+}